@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "include/engine/cellCoordinator.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+//////////////////////////////////////////////////////////////
+// Allocation counting (every replaceable global operator new/delete)
+//////////////////////////////////////////////////////////////
+static std::atomic<long> allocations{0};
+
+//! Counted allocation shared by every operator new (nullptr on failure)
+//! Kept out of line, so the compiler does not pair an inlined malloc/free with the new/delete of a caller
+[[gnu::noinline]] void* countedAllocate(std::size_t size, std::size_t alignment) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    size = std::max<std::size_t>(size, 1);
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+[[gnu::noinline]] void countedRelease(void* p) noexcept {
+    std::free(p);
+}
+
+void* countedNew(std::size_t size, std::size_t alignment) {
+    if (void* p = countedAllocate(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return countedNew(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return countedNew(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t a) { return countedNew(size, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t size, std::align_val_t a) { return countedNew(size, static_cast<std::size_t>(a)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return countedAllocate(size, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return countedAllocate(size, static_cast<std::size_t>(a)); }
+
+void operator delete(void* p) noexcept { countedRelease(p); }
+void operator delete[](void* p) noexcept { countedRelease(p); }
+void operator delete(void* p, std::size_t) noexcept { countedRelease(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedRelease(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedRelease(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedRelease(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedRelease(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedRelease(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedRelease(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedRelease(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedRelease(p); }
+
+using Clock = std::chrono::steady_clock;
+
+struct StepCost {
+    double allocationsPerStep;
+    double microsecondsPerStep;
+};
+
+//! Runs steps time units of a coordinator (after start) and measures allocations and time per step
+template <typename Store>
+StepCost measureCoordinator(const Scenario& scenario, int steps) {
+    CellCoordinator<Store> coordinator(scenario);
+    coordinator.start();
+    coordinator.simulateUntil(0.0);     // warm-up: first step evaluates every cell
+
+    long before = allocations.load();
+    auto start = Clock::now();
+    for (int t = 1; t <= steps; ++t) {
+        coordinator.simulateUntil(static_cast<double>(t));
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return {static_cast<double>(allocations.load() - before) / steps, elapsed / steps};
+}
+
+StepCost measureGridEngine(const Scenario& scenario, int steps) {
+    GridEngine engine(scenario);
+    engine.step();
+
+    long before = allocations.load();
+    auto start = Clock::now();
+    for (int t = 1; t <= steps; ++t) {
+        engine.step();
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return {static_cast<double>(allocations.load() - before) / steps, elapsed / steps};
+}
+
+//! Allocations of a pooled coordinator from its first instant (every cell receives) to time steps
+long pooledAllocationsFromStart(const Scenario& scenario, int steps) {
+    CellCoordinator<PooledMessageStore> coordinator(scenario);
+    coordinator.start();
+    long before = allocations.load();
+    coordinator.simulateUntil(static_cast<double>(steps));
+    return allocations.load() - before;
+}
+
+void report(const std::string& name, const Scenario& scenario, int steps) {
+    std::cout << name << " (" << scenario.rows << "x" << scenario.cols << ", " << steps << " steps)" << std::endl;
+    auto print = [](const std::string& mode, const StepCost& cost) {
+        std::cout << "  " << std::left << std::setw(34) << mode << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << cost.allocationsPerStep << std::setw(14) << cost.microsecondsPerStep << std::endl;
+    };
+    std::cout << "  " << std::left << std::setw(34) << "mode" << std::right << std::setw(12) << "allocs/step" << std::setw(14) << "us/step" << std::endl;
+    print("coordinator (shared snapshots)", measureCoordinator<SharedMessageStore>(scenario, steps));
+    print("coordinator (pooled)", measureCoordinator<PooledMessageStore>(scenario, steps));
+    print("synchronous grid engine", measureGridEngine(scenario, steps));
+}
+
+int main(int argc, char ** argv) {
+    int size = 256;
+    int steps = 100;
+    int oddSize = 300;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--odd-size" && i + 1 < argc) {
+            oddSize = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    for (const auto& config: configs) {
+        report(config, loadScenario(config), steps);
+    }
+
+    GeneratorParameters params;
+    params.rows = size;
+    params.cols = size;
+    report("generated", generateScenario(params), steps);
+
+    // the step arena must hold the worst instant on any grid, not only when the cell count is a power of two
+    params.rows = oddSize;
+    params.cols = oddSize;
+    long spilled = pooledAllocationsFromStart(generateScenario(params), steps);
+    std::cout << "pooled coordinator on " << oddSize << "x" << oddSize << ", first instant included: " << spilled << " allocations" << std::endl;
+    if (spilled != 0) {
+        std::cout << "FAIL the pooled step allocated memory" << std::endl;
+        return 1;
+    }
+}
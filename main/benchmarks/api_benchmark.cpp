@@ -0,0 +1,106 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/api/fpi.h"
+#include "include/api/simulation.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/gridLogger.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+//! Microseconds per step of a step function, measured over complete runs for at least minSeconds
+template <typename Reset, typename Step>
+double microsecondsPerStep(int steps, double minSeconds, Reset reset, Step step) {
+    long total = 0;
+    double elapsed = 0.0;
+    auto start = Clock::now();
+    do {
+        reset();
+        for (int i = 0; i < steps; ++i) {
+            step();
+        }
+        total += steps;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return 1e6 * elapsed / total;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " SCENARIO_CONFIG.json... [--steps N (default: 500)]" << std::endl;
+        return -1;
+    }
+
+    int steps = 500;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    std::cout << std::left << std::setw(48) << "scenario" << std::right << std::setw(12) << "engine" << std::setw(12) << "C++ API"
+              << std::setw(12) << "C API" << std::setw(14) << "standalone" << "   (us/step)" << std::endl;
+    for (const auto& config: configs) {
+        Scenario scenario = loadScenario(config);
+
+        // engine stepped directly (no API layer)
+        GridEngine engine(scenario);
+        double engineUs = microsecondsPerStep(steps, 0.5, [&]() { engine.reset(); }, [&]() { engine.step(); });
+
+        // C++ API: step and read the grid view between steps
+        Simulation simulation(scenario);
+        long checksum = 0;
+        double cppUs = microsecondsPerStep(steps, 0.5, [&]() { simulation.reset(); }, [&]() {
+            simulation.step();
+            checksum += simulation.grid()[0].inactive_time;
+        });
+
+        // C API: same loop through the opaque handle
+        fpi_simulation* handle = fpi_load(config.c_str());
+        if (handle == nullptr) {
+            std::cerr << fpi_last_error() << std::endl;
+            return -1;
+        }
+        const int cells = fpi_rows(handle) * fpi_cols(handle);
+        double cUs = microsecondsPerStep(steps, 0.5, [&]() { fpi_reset(handle); }, [&]() {
+            fpi_step(handle, 1);
+            checksum += fpi_grid(handle)[cells - 1].inactive_time;
+        });
+
+        // standalone run (what football_player_interaction does per step): copy of the previous grid and CSV log
+        GridLogger logger("/dev/null", ";");
+        std::vector<playerState> before;
+        double standaloneUs = microsecondsPerStep(steps, 0.5, [&]() { simulation.reset(); }, [&]() {
+            before.assign(simulation.grid().begin(), simulation.grid().end());
+            simulation.step();
+            logger.logChanges(simulation.time() - 1, scenario, before, simulation.grid());
+        });
+
+        // every path must end in the same grid
+        bool identical = true;
+        engine.reset();
+        simulation.reset();
+        fpi_reset(handle);
+        for (int i = 0; i < steps; ++i) {
+            engine.step();
+        }
+        simulation.step(steps);
+        fpi_step(handle, steps);
+        for (int i = 0; i < cells; ++i) {
+            const fpi_cell_state& c = fpi_grid(handle)[i];
+            identical = identical && !(engine.states()[i] != simulation.grid()[i]) && c.mental == engine.states()[i].mental && c.has_player == engine.states()[i].has_player;
+        }
+        fpi_destroy(handle);
+
+        std::cout << std::left << std::setw(48) << config << std::right << std::fixed << std::setprecision(3) << std::setw(12) << engineUs
+                  << std::setw(12) << cppUs << std::setw(12) << cUs << std::setw(14) << standaloneUs
+                  << (identical ? "" : "   (results differ)") << (checksum < 0 ? "!" : "") << std::endl;
+    }
+}
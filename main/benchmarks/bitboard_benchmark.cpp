@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/occupancyBitboard.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+//! Packs the occupancy flags of a cell (and the near_obstacle it raises) into one word for comparison
+std::uint32_t packOccupancy(const NeighborFlags& f, const playerState& state) {
+    const bool bits[] = {
+        f.north_empty, f.south_empty, f.east_empty, f.west_empty,
+        f.north_teammate, f.south_teammate, f.east_teammate, f.west_teammate,
+        f.north_extended_teammate, f.south_extended_teammate,
+        f.obstacle_interception_north, f.obstacle_interception_south,
+        f.near_north_obstacle, f.near_south_obstacle, f.near_east_obstacle, f.near_west_obstacle,
+        state.near_obstacle
+    };
+    std::uint32_t packed = 0;
+    for (bool bit: bits) {
+        packed = (packed << 1) | (bit ? 1 : 0);
+    }
+    return packed;
+}
+
+//! Occupancy flags of every cell read from the neighbor states (collectOccupancyFlags)
+void structFlags(const Scenario& scenario, const std::vector<playerState>& grid, std::vector<std::uint32_t>& out) {
+    for (int row = 0; row < scenario.rows; ++row) {
+        for (int col = 0; col < scenario.cols; ++col) {
+            const int i = scenario.index(row, col);
+            playerState state = grid[i];
+            NeighborFlags flags;
+            collectOccupancyFlags(state, scenario.gatherNeighbors(grid, row, col), flags);
+            out[i] = packOccupancy(flags, state);
+        }
+    }
+}
+
+//! Occupancy flags of every cell extracted from the bitboard row masks
+void bitboardFlags(const Scenario& scenario, const std::vector<playerState>& grid, const OccupancyBitboard& bitboard, RowMasks& masks, std::vector<std::uint32_t>& out) {
+    for (int row = 0; row < scenario.rows; ++row) {
+        bitboard.computeRowMasks(row, masks);
+        for (int w = 0; w < bitboard.wordsPerRow(); ++w) {
+            const RowMasks::Word bits = masks.word(w);
+            for (int col = w * 64; col < std::min(scenario.cols, w * 64 + 64); ++col) {
+                const int i = scenario.index(row, col);
+                playerState state = grid[i];
+                NeighborFlags flags;
+                RowMasks::applyTo(bits, col & 63, state, flags);
+                out[i] = packOccupancy(flags, state);
+            }
+        }
+    }
+}
+
+//! Row masks only (what the shifts and ANDs cost for the whole grid), returns a checksum
+std::uint64_t bitboardMasks(const Scenario& scenario, const OccupancyBitboard& bitboard, RowMasks& masks) {
+    std::uint64_t checksum = 0;
+    for (int row = 0; row < scenario.rows; ++row) {
+        bitboard.computeRowMasks(row, masks);
+        checksum += masks.mask(OBSTACLE_ADJACENT_MASK)[0] ^ masks.mask(EAST_EMPTY_MASK)[0];
+    }
+    return checksum;
+}
+
+bool sameGrid(const std::vector<playerState>& a, const std::vector<playerState>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const playerState& x, const playerState& y) { return !(x != y); });
+}
+
+//! Average milliseconds of a call over repeats calls
+template <typename Function>
+double millisecondsPerCall(int repeats, Function function) {
+    auto start = Clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        function();
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+}
+
+void report(Scenario scenario, int steps, int repeats) {
+    std::cout << "generated " << scenario.rows << "x" << scenario.cols << (scenario.wrapped ? " (wrapped)" : "") << std::endl;
+
+    // measure on a grid that already evolved for a few steps (actions, moved players, near_obstacle raised)
+    GridEngine warmup(scenario);
+    for (int i = 0; i < 3; ++i) {
+        warmup.step();
+    }
+    const std::vector<playerState> grid = warmup.states();
+
+    OccupancyBitboard bitboard(scenario);
+    bitboard.build(grid);
+    RowMasks masks(bitboard.wordsPerRow());
+    std::vector<std::uint32_t> expected(scenario.size());
+    std::vector<std::uint32_t> actual(scenario.size());
+
+    structFlags(scenario, grid, expected);
+    bitboardFlags(scenario, grid, bitboard, masks, actual);
+    std::cout << "  occupancy flags identical: " << ((expected == actual) ? "yes" : "NO") << std::endl;
+
+    std::uint64_t checksum = 0;
+    double structMs = millisecondsPerCall(repeats, [&]() { structFlags(scenario, grid, expected); });
+    double bitboardMs = millisecondsPerCall(repeats, [&]() { bitboardFlags(scenario, grid, bitboard, masks, actual); });
+    double masksMs = millisecondsPerCall(repeats, [&]() { checksum += bitboardMasks(scenario, bitboard, masks); });
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  per-neighbor struct reads:   " << std::setw(10) << structMs << " ms/grid" << std::endl;
+    std::cout << "  bitboard masks + extraction: " << std::setw(10) << bitboardMs << " ms/grid" << std::endl;
+    std::cout << "  bitboard row masks only:     " << std::setw(10) << masksMs << " ms/grid  (checksum " << checksum % 1000 << ")" << std::endl;
+
+    // complete engine steps with and without bitboards
+    GridEngine structEngine(scenario);
+    GridEngine bitboardEngine(scenario);
+    bitboardEngine.enableBitboards();
+    double structStepMs = millisecondsPerCall(steps, [&]() { structEngine.step(); });
+    double bitboardStepMs = millisecondsPerCall(steps, [&]() { bitboardEngine.step(); });
+    std::cout << "  engine step (struct reads):  " << std::setw(10) << structStepMs << " ms/step" << std::endl;
+    std::cout << "  engine step (bitboards):     " << std::setw(10) << bitboardStepMs << " ms/step" << std::endl;
+    std::cout << "  final grids identical: " << (sameGrid(structEngine.states(), bitboardEngine.states()) ? "yes" : "NO") << std::endl;
+}
+
+int main(int argc, char ** argv) {
+    int size = 2048;
+    int steps = 10;
+    int repeats = 5;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--repeats" && i + 1 < argc) {
+            repeats = std::stoi(argv[++i]);
+        }
+    }
+
+    GeneratorParameters params;
+    params.rows = size;
+    params.cols = size + 37;        // row length not a multiple of 64 (partial last word)
+    Scenario scenario = generateScenario(params);
+    report(scenario, steps, repeats);
+
+    scenario.wrapped = true;
+    report(scenario, steps, repeats);
+}
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <spawn.h>
+#include <sys/wait.h>
+#include "include/daemon/simulationDaemon.hpp"
+
+extern char ** environ;
+
+using Clock = std::chrono::steady_clock;
+
+//! Runs football_player_interaction once in a directory and waits for it
+void runProcess(const std::string& program, const std::string& config, const std::string& simTime, const std::string& dir) {
+    std::vector<std::string> args = {program, config, simTime};
+    std::vector<char*> argv;
+    for (auto& arg: args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addchdir_np(&actions, dir.c_str());
+    pid_t pid;
+    int status = 0;
+    bool spawned = posix_spawn(&pid, program.c_str(), &actions, nullptr, argv.data(), environ) == 0;
+    posix_spawn_file_actions_destroy(&actions);
+    if (!spawned || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("unable to run " + program);
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+//! Job latencies in milliseconds, measured by the clients (jobs are split between the clients, one at a time each)
+template <typename Job>
+std::vector<double> measure(int jobs, int clients, Job job) {
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c]() {
+            for (int j = c; j < jobs; j += clients) {
+                auto start = Clock::now();
+                job(c, j);
+                latencies[c].push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            }
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    std::vector<double> all;
+    for (const auto& l: latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+void report(const std::string& mode, const std::vector<double>& latencies, double seconds) {
+    auto percentile = [&](double p) {
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+    };
+    double mean = 0.0;
+    for (double l: latencies) {
+        mean += l / latencies.size();
+    }
+    std::cout << std::left << std::setw(34) << mode << std::right << std::fixed << std::setprecision(3) << std::setw(10) << percentile(0.5)
+              << std::setw(10) << percentile(0.99) << std::setw(10) << mean << std::setprecision(1) << std::setw(12)
+              << latencies.size() / seconds << std::endl;
+}
+
+int main(int argc, char ** argv) {
+    int jobs = 200;
+    int clients = 1;
+    unsigned workers = 1;
+    std::string simTime = "500";
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::stoi(argv[++i]);
+        } else if (arg == "--clients" && i + 1 < argc) {
+            clients = std::stoi(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = std::stoul(argv[++i]);
+        } else if (arg == "--time" && i + 1 < argc) {
+            simTime = argv[++i];
+        } else {
+            configs.push_back(std::filesystem::absolute(arg).string());
+        }
+    }
+    if (configs.empty()) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " SCENARIO_CONFIG.json... [--jobs N (default: 200)] [--time T (default: 500)] "
+                  << "[--workers N (default: 1)] [--clients N (default: 1)]" << std::endl;
+        return -1;
+    }
+
+    // the processes and the daemon write their logs in a scratch directory (one per client), the log directory of the daemon
+    const std::string program = (std::filesystem::absolute(argv[0]).parent_path() / "football_player_interaction").string();
+    const auto scratch = std::filesystem::temp_directory_path() / ("daemon_benchmark_" + std::to_string(::getpid()));
+    for (int c = 0; c < clients; ++c) {
+        std::filesystem::create_directories(scratch / std::to_string(c));
+    }
+    const std::string socketPath = (scratch / "daemon.sock").string();
+
+    SimulationDaemon daemon(socketPath, workers, 8, std::max(DEFAULT_MAX_JOB_TIME, std::stod(simTime)), scratch.string());
+    std::thread server([&daemon]() { daemon.serve(); });
+    std::vector<std::unique_ptr<DaemonClient>> connections;
+    for (int c = 0; c < clients; ++c) {
+        connections.push_back(std::make_unique<DaemonClient>(socketPath));
+    }
+
+    // the daemon logs the same entries as one process per run
+    bool identical = true;
+    for (const auto& config: configs) {
+        runProcess(program, config, simTime, (scratch / "0").string());
+        nlohmann::json reply = connections[0]->request({{"config", config}, {"time", std::stod(simTime)}, {"log", "daemon_log.csv"}});
+        identical = identical && reply.value("ok", false) && readFile(scratch / "0" / "grid_log.csv") == readFile(scratch / "daemon_log.csv");
+    }
+
+    std::cout << configs.size() << " scenario(s), " << jobs << " jobs of " << simTime << " time units, " << clients << " client(s), "
+              << workers << " worker(s)" << (identical ? "" : "   (logs differ)") << std::endl;
+    std::cout << std::left << std::setw(34) << "mode" << std::right << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "mean" << std::setw(12) << "jobs/s" << "   (ms)" << std::endl;
+
+    auto timed = [&](const std::string& mode, auto job) {
+        auto start = Clock::now();
+        std::vector<double> latencies = measure(jobs, clients, job);
+        report(mode, latencies, std::chrono::duration<double>(Clock::now() - start).count());
+    };
+    timed("one process per run", [&](int c, int j) {
+        runProcess(program, configs[j % configs.size()], simTime, (scratch / std::to_string(c)).string());
+    });
+    timed("daemon, grid_log.csv", [&](int c, int j) {
+        connections[c]->request({{"config", configs[j % configs.size()]}, {"time", std::stod(simTime)},
+                                 {"log", std::to_string(c) + "/daemon_log.csv"}});
+    });
+    timed("daemon, summary only", [&](int c, int j) {
+        connections[c]->request({{"config", configs[j % configs.size()]}, {"time", std::stod(simTime)}});
+    });
+
+    connections.clear();
+    daemon.requestStop();
+    server.join();
+    std::filesystem::remove_all(scratch);
+}
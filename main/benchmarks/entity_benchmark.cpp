@@ -0,0 +1,114 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/engine/entityEngine.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+//! Every player (ball) cell holds exactly one entity of that kind that is not in flight
+bool entitiesMatchCells(const EntityEngine& engine, const std::vector<playerState>& grid) {
+    const Scenario& scenario = engine.getScenario();
+    std::vector<int> players(grid.size(), 0), balls(grid.size(), 0);
+    for (const Entity& entity: engine.getEntities()) {
+        if (!entity.inFlight) {
+            ++(entity.kind == EntityKind::PLAYER ? players : balls)[scenario.index(entity.row, entity.col)];
+        }
+    }
+    for (std::size_t i = 0; i < grid.size(); ++i) {
+        if (players[i] != (grid[i].has_player ? 1 : 0) || balls[i] != (grid[i].has_ball ? 1 : 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Steps both engines side by side and checks every step (states and entities)
+bool sameSteps(const Scenario& scenario, int steps, std::optional<std::uint64_t> seed) {
+    GridEngine grid(scenario);
+    EntityEngine entities(scenario);
+    if (seed) {
+        grid.setSeed(*seed);
+        entities.setSeed(*seed);
+    }
+    for (int t = 0; t < steps; ++t) {
+        grid.step();
+        entities.step();
+        const std::vector<playerState> states = entities.states();
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            if (states[i] != grid.states()[i]) {
+                return false;
+            }
+        }
+        if (!entitiesMatchCells(entities, states)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void compare(const std::string& name, const Scenario& scenario, int steps) {
+    GridEngine grid(scenario);
+    EntityEngine entities(scenario);
+
+    auto start = Clock::now();
+    for (int t = 0; t < steps; ++t) {
+        grid.step();
+    }
+    double gridUs = 1e6 * std::chrono::duration<double>(Clock::now() - start).count() / steps;
+
+    long evaluated = 0;
+    start = Clock::now();
+    for (int t = 0; t < steps; ++t) {
+        entities.step();
+        evaluated += entities.evaluatedCells();
+    }
+    double entityUs = 1e6 * std::chrono::duration<double>(Clock::now() - start).count() / steps;
+
+    int players = 0;
+    for (const Entity& entity: entities.getEntities()) {
+        players += (entity.kind == EntityKind::PLAYER) ? 1 : 0;
+    }
+    bool identical = sameSteps(scenario, steps, std::nullopt) && sameSteps(scenario, steps, 7);
+
+    std::cout << std::left << std::setw(72) << name << std::right << std::setw(9) << players << std::setw(11) << evaluated / steps
+              << std::setw(9) << entities.storedCells() << std::fixed << std::setprecision(3) << std::setw(14) << gridUs
+              << std::setw(12) << entityUs << (identical ? "" : "   (results differ)") << std::endl;
+}
+
+int main(int argc, char ** argv) {
+    int steps = 200;
+    int size = 1024;
+    int players = 200;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else if (arg == "--players" && i + 1 < argc) {
+            players = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    std::cout << std::left << std::setw(72) << "scenario" << std::right << std::setw(9) << "players" << std::setw(11) << "evaluated"
+              << std::setw(9) << "stored" << std::setw(14) << "grid" << std::setw(12) << "entities" << "   (us/step)" << std::endl;
+    for (const auto& config: configs) {
+        compare(config, loadScenario(config), steps);
+    }
+    for (int count: {players / 4, players}) {
+        GeneratorParameters params;
+        params.rows = size;
+        params.cols = size;
+        params.playerDensity = static_cast<double>(count) / (static_cast<double>(size) * size);
+        params.obstacleDensity = params.playerDensity;
+        compare("generated " + std::to_string(size) + "x" + std::to_string(size) + ", about " + std::to_string(count) + " players",
+                generateScenario(params), steps / 4);
+    }
+}
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/engine/fixedGridEngine.hpp"
+#include "include/engine/gridEngine.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+//! Complete runs (reset + steps) per second of an engine, measured for at least minSeconds
+template <typename Engine>
+double runsPerSecond(Engine& engine, int steps, double minSeconds) {
+    long runs = 0;
+    double elapsed = 0.0;
+    auto start = Clock::now();
+    do {
+        engine.reset();
+        for (int i = 0; i < steps; ++i) {
+            engine.step();
+        }
+        ++runs;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return runs / elapsed;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " SCENARIO_CONFIG.json... [--steps N (default: 500)]" << std::endl;
+        return -1;
+    }
+
+    int steps = 500;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    std::cout << std::left << std::setw(48) << "scenario" << std::right << std::setw(14) << "grid runs/s" << std::setw(14) << "fixed runs/s" << std::setw(10) << "speedup" << std::endl;
+    for (const auto& config: configs) {
+        Scenario scenario = loadScenario(config);
+
+        GridEngine grid(scenario);
+        double gridRuns = runsPerSecond(grid, steps, 0.5);
+
+        double fixedRuns = 0.0;
+        bool identical = true;
+        visitFixedGridEngine(scenario, [&](auto& fixed) {
+            fixedRuns = runsPerSecond(fixed, steps, 0.5);
+
+            // both engines must end the run in the same grid
+            grid.reset();
+            fixed.reset();
+            for (int i = 0; i < steps; ++i) {
+                grid.step();
+                fixed.step();
+            }
+            for (int i = 0; i < scenario.size(); ++i) {
+                identical = identical && !(grid.states()[i] != fixed.states()[i]);
+            }
+        });
+
+        std::string name = std::filesystem::path(config).parent_path().filename().string() + "/" + std::filesystem::path(config).filename().string();
+        std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(0) << std::setw(14) << gridRuns;
+        if (fixedRuns > 0.0) {
+            std::cout << std::setw(14) << fixedRuns << std::setw(9) << std::setprecision(2) << fixedRuns / gridRuns << "x";
+        } else {
+            std::cout << std::setw(14) << "-" << std::setw(10) << "-";
+        }
+        std::cout << (identical ? "" : "  MISMATCH") << std::endl;
+        if (!identical) {
+            return 1;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/multiResolutionEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+double megabytes(std::size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+//! Compares every cell of both engines
+bool sameGrid(const GridEngine& flat, const MultiResolutionEngine& multi) {
+    const Scenario& scenario = flat.getScenario();
+    for (int row = 0; row < scenario.rows; ++row) {
+        for (int col = 0; col < scenario.cols; ++col) {
+            if (flat.states()[scenario.index(row, col)] != multi.cell(row, col)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char ** argv) {
+    int size = 4096;
+    int players = 48;
+    int steps = 20;
+    int tileSize = MultiResolutionEngine::DEFAULT_TILE_SIZE;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else if (arg == "--players" && i + 1 < argc) {
+            players = std::stoi(argv[++i]);
+        } else if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--tile" && i + 1 < argc) {
+            tileSize = std::stoi(argv[++i]);
+        }
+    }
+
+    GeneratorParameters params;
+    params.rows = size;
+    params.cols = size;
+    params.playerDensity = static_cast<double>(players) / (static_cast<double>(size) * size);
+    params.obstacleDensity = params.playerDensity / 2;
+    Scenario scenario = generateScenario(params);
+    std::cout << "generated " << size << "x" << size << " grid, about " << players << " players, " << steps << " steps, "
+              << tileSize << "x" << tileSize << " tiles" << std::endl;
+
+    auto start = Clock::now();
+    MultiResolutionEngine multi(scenario, tileSize);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // the flat engine keeps the scenario (initial grid) and two step buffers
+    const std::size_t flatBytes = 3 * static_cast<std::size_t>(scenario.size()) * sizeof(playerState);
+    GridEngine flat(std::move(scenario));
+
+    bool identical = sameGrid(flat, multi);
+    double flatMs = 0.0;
+    double multiMs = 0.0;
+    int maxDense = multi.denseTiles();
+    for (int t = 0; t < steps; ++t) {
+        start = Clock::now();
+        flat.step();
+        flatMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        multi.step();
+        multiMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        maxDense = std::max(maxDense, multi.denseTiles());
+    }
+    identical = identical && sameGrid(flat, multi);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  flat grid engine:       " << std::setw(12) << megabytes(flatBytes) << " MB  " << std::setw(12) << flatMs / steps << " ms/step" << std::endl;
+    std::cout << "  multi-resolution grid:  " << std::setw(12) << megabytes(multi.memoryBytes()) << " MB  " << std::setw(12) << multiMs / steps << " ms/step"
+              << "  (build " << buildMs << " ms)" << std::endl;
+    std::cout << "  quadtree nodes: " << multi.nodeCount() << ", dense tiles: " << multi.denseTiles() << " (max " << maxDense << ")" << std::endl;
+    std::cout << "  final grids identical: " << (identical ? "yes" : "NO") << std::endl;
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+//! Microseconds per step of an engine, measured over complete runs for at least minSeconds
+double microsecondsPerStep(GridEngine& engine, int steps, double minSeconds) {
+    long total = 0;
+    double elapsed = 0.0;
+    auto start = Clock::now();
+    do {
+        engine.reset();
+        for (int i = 0; i < steps; ++i) {
+            engine.step();
+        }
+        total += steps;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return 1e6 * elapsed / total;
+}
+
+//! Steps both engines side by side and checks that every step gives the same grid (obstacles are injected by hand
+//! into both at the given step, every 7th cell of row 1)
+bool sameSteps(GridEngine& plain, GridEngine& field, int steps, int injectAt) {
+    plain.reset();
+    field.reset();
+    for (int t = 0; t < steps; ++t) {
+        if (t == injectAt) {
+            playerState obstacle;
+            obstacle.has_obstacle = true;
+            const Scenario& scenario = plain.getScenario();
+            for (int col = 0; col < scenario.cols; col += 7) {
+                plain.setCell(std::min(1, scenario.rows - 1), col, obstacle);
+                field.setCell(std::min(1, scenario.rows - 1), col, obstacle);
+            }
+        }
+        plain.step();
+        field.step();
+        for (std::size_t i = 0; i < plain.states().size(); ++i) {
+            if (plain.states()[i] != field.states()[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void compare(const std::string& name, const Scenario& scenario, int steps) {
+    GridEngine plain(scenario);
+    GridEngine field(scenario);
+    field.enableObstacleField();
+
+    int obstacles = 0;
+    for (const auto& s: scenario.initial) {
+        obstacles += isObstacle(s) ? 1 : 0;
+    }
+
+    double plainUs = microsecondsPerStep(plain, steps, 0.5);
+    double fieldUs = microsecondsPerStep(field, steps, 0.5);
+    const int elided = field.elidedCells();
+    bool identical = sameSteps(plain, field, steps, -1) && sameSteps(plain, field, steps, steps / 3);
+
+    std::cout << std::left << std::setw(72) << name << std::right << std::setw(10) << obstacles << std::setw(10) << elided
+              << std::fixed << std::setprecision(3) << std::setw(14) << plainUs << std::setw(14) << fieldUs
+              << std::setprecision(2) << std::setw(10) << plainUs / fieldUs << "x" << (identical ? "" : "   (results differ)") << std::endl;
+}
+
+int main(int argc, char ** argv) {
+    int steps = 200;
+    int size = 256;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    std::cout << std::left << std::setw(72) << "scenario" << std::right << std::setw(10) << "obstacles" << std::setw(10) << "elided"
+              << std::setw(14) << "neighbors" << std::setw(14) << "field" << std::setw(11) << "speedup" << "   (us/step)" << std::endl;
+    for (const auto& config: configs) {
+        compare(config, loadScenario(config), steps);
+    }
+    for (double density: {0.1, 0.3, 0.6}) {
+        GeneratorParameters params;
+        params.rows = size;
+        params.cols = size;
+        params.obstacleDensity = density;
+        compare("generated " + std::to_string(size) + "x" + std::to_string(size) + ", obstacle density " + std::to_string(density).substr(0, 3),
+                generateScenario(params), steps / 4);
+    }
+}
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "include/engine/cellCoordinator.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+#include "include/engine/stateHash.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct RunCost {
+    double evaluationsPerStep;
+    double microsecondsPerStep;
+};
+
+RunCost measureGridEngine(const Scenario& scenario, int steps, bool passive) {
+    GridEngine engine(scenario);
+    if (passive) {
+        engine.enablePassivation();
+    }
+    auto start = Clock::now();
+    for (int t = 0; t < steps; ++t) {
+        engine.step();
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return {static_cast<double>(engine.evaluatedCells()) / steps, elapsed / steps};
+}
+
+//! Cadmium semantics: a cell is only evaluated when a neighbor output arrives (with passive cells, the rules only run
+//! for the transitions of cells that are not passive; finalStates receives the grid at the end of the run)
+RunCost measureCoordinator(const Scenario& scenario, int steps, bool passive, std::vector<playerState>& finalStates) {
+    auto model = std::make_shared<const PassivePlayerCellModel>();
+    CellCoordinator<PooledMessageStore>::ModelFactory factory = nullptr;
+    if (passive) {
+        factory = [&model](int, int) { return model; };
+    }
+    CellCoordinator<PooledMessageStore> coordinator(scenario, factory);
+    auto start = Clock::now();
+    coordinator.start();
+    coordinator.simulateUntil(static_cast<double>(steps - 1));
+    double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    finalStates = coordinator.states();
+    const long evaluations = passive ? model->ruleEvaluations() : coordinator.getStatistics().transitions;
+    return {static_cast<double>(evaluations) / steps, elapsed / steps};
+}
+
+//! Steps a passive and a full engine side by side and checks every step (an obstacle and a player are injected into
+//! both at the given step)
+bool sameSteps(const Scenario& scenario, int steps, std::optional<std::uint64_t> seed, int injectAt) {
+    GridEngine full(scenario);
+    GridEngine passive(scenario);
+    passive.enablePassivation();
+    if (seed) {
+        full.setSeed(*seed);
+        passive.setSeed(*seed);
+    }
+    for (int t = 0; t < steps; ++t) {
+        if (t == injectAt) {
+            playerState obstacle;
+            obstacle.has_obstacle = true;
+            playerState player;
+            player.has_player = true;
+            player.has_ball = true;
+            player.mental = 80.0;
+            player.fatigue = 10.0;
+            for (GridEngine* engine: {&full, &passive}) {
+                engine->setCell(scenario.rows / 2, scenario.cols / 2, obstacle);
+                engine->setCell(scenario.rows - 1, 0, player);
+            }
+        }
+        full.step();
+        passive.step();
+        for (std::size_t i = 0; i < full.states().size(); ++i) {
+            if (full.states()[i] != passive.states()[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void report(const std::string& name, const Scenario& scenario, int steps) {
+    RunCost full = measureGridEngine(scenario, steps, false);
+    RunCost passive = measureGridEngine(scenario, steps, true);
+    std::vector<playerState> coordinatorStates;
+    std::vector<playerState> passiveCellStates;
+    RunCost coordinator = measureCoordinator(scenario, steps, false, coordinatorStates);
+    RunCost passiveCells = measureCoordinator(scenario, steps, true, passiveCellStates);
+    bool identical = sameSteps(scenario, steps, std::nullopt, -1) && sameSteps(scenario, steps, 11, -1) &&
+                     sameSteps(scenario, steps, std::nullopt, steps / 2) && hashGrid(coordinatorStates) == hashGrid(passiveCellStates);
+
+    std::cout << name << " (" << scenario.rows << "x" << scenario.cols << ", " << steps << " steps)"
+              << (identical ? "" : "   (results differ)") << std::endl;
+    auto print = [](const std::string& mode, const RunCost& cost) {
+        std::cout << "  " << std::left << std::setw(34) << mode << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << cost.evaluationsPerStep << std::setw(14) << cost.microsecondsPerStep << std::endl;
+    };
+    std::cout << "  " << std::left << std::setw(34) << "mode" << std::right << std::setw(16) << "evaluations/step" << std::setw(14) << "us/step" << std::endl;
+    print("grid engine (every cell)", full);
+    print("grid engine (passivation)", passive);
+    print("coordinator (Cadmium semantics)", coordinator);
+    print("coordinator (passive cells)", passiveCells);
+}
+
+int main(int argc, char ** argv) {
+    int steps = 200;
+    int size = 1024;
+    int players = 200;
+    std::vector<std::string> configs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--steps" && i + 1 < argc) {
+            steps = std::stoi(argv[++i]);
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = std::stoi(argv[++i]);
+        } else if (arg == "--players" && i + 1 < argc) {
+            players = std::stoi(argv[++i]);
+        } else {
+            configs.push_back(arg);
+        }
+    }
+
+    for (const auto& config: configs) {
+        report(config, loadScenario(config), steps);
+    }
+
+    GeneratorParameters params;
+    params.rows = size;
+    params.cols = size;
+    params.playerDensity = static_cast<double>(players) / (static_cast<double>(size) * size);
+    params.obstacleDensity = params.playerDensity;
+    report("generated, about " + std::to_string(players) + " players", generateScenario(params), steps / 4);
+}
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "include/data_structures/philox.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/scenarioGenerator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//! Throughput of the counter-based stream against a (shared, stateful) mt19937
+static void benchmarkGenerators(std::uint64_t draws) {
+    double sink = 0.0;
+
+    auto start = Clock::now();
+    std::uint64_t step = 0;
+    for (std::uint64_t i = 0; i < draws; i += 4, ++step) {
+        DecisionSampler sampler(42, static_cast<int>(i & 0xFFFF), static_cast<int>(i >> 16), step);
+        for (int j = 0; j < 4; ++j) {
+            sink += sampler.uniform();
+        }
+    }
+    double philox = secondsSince(start);
+
+    start = Clock::now();
+    std::mt19937 generator(42);
+    for (std::uint64_t i = 0; i < draws; ++i) {
+        sink += Philox4x32::toUnit(generator());
+    }
+    double twister = secondsSince(start);
+
+    std::cout << "generator      draws/s" << std::endl;
+    std::cout << "philox4x32-10  " << std::scientific << std::setprecision(3) << draws / philox << std::endl;
+    std::cout << "mt19937        " << draws / twister << std::endl;
+    std::cout << "(checksum " << std::fixed << sink << ")" << std::endl << std::endl;
+}
+
+//! Stochastic engine throughput per thread count; every run must end in the same grid
+static void benchmarkEngine(int size, int steps, const std::vector<unsigned>& threadCounts) {
+    GeneratorParameters params;
+    params.rows = size;
+    params.cols = size;
+    Scenario scenario = generateScenario(params);
+
+    std::vector<playerState> reference;
+    std::cout << "grid " << size << "x" << size << ", " << steps << " stochastic steps" << std::endl;
+    std::cout << "threads  cells/s       identical" << std::endl;
+    for (unsigned threads: threadCounts) {
+        GridEngine engine(scenario);
+        engine.setSeed(2024);
+
+        auto start = Clock::now();
+        for (int i = 0; i < steps; ++i) {
+            engine.step(threads);
+        }
+        double elapsed = secondsSince(start);
+
+        if (reference.empty()) {
+            reference = engine.states();
+        }
+        bool identical = true;
+        for (size_t i = 0; i < reference.size(); ++i) {
+            identical = identical && !(reference[i] != engine.states()[i]);
+        }
+        std::cout << std::setw(7) << threads << "  " << std::scientific << std::setprecision(3)
+                  << static_cast<double>(scenario.size()) * steps / elapsed << "     " << (identical ? "yes" : "NO") << std::endl;
+        if (!identical) {
+            std::exit(1);
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    int size = (argc > 1) ? std::stoi(argv[1]) : 512;
+    int steps = (argc > 2) ? std::stoi(argv[2]) : 20;
+
+    benchmarkGenerators(1 << 26);
+    benchmarkEngine(size, steps, {1, 2, 3, 4, 8});
+}
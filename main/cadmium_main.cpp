@@ -0,0 +1,65 @@
+#include "nlohmann/json.hpp"
+#include <cadmium/modeling/celldevs/grid/coupled.hpp>
+#include <cadmium/simulation/logger/csv.hpp>
+#include <cadmium/simulation/root_coordinator.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <fstream>
+#include <string>
+#include "include/playerCell.hpp"
+
+using namespace cadmium::celldevs;
+using namespace cadmium;
+
+bool passiveCells = false;                          // --passive: player cells are passivePlayer cells
+std::shared_ptr<CellEventCounts> eventCounts;       // --events: counted by every player cell
+
+std::shared_ptr<GridCell<playerState, double>> addGridCell(const coordinates & cellId, const std::shared_ptr<const GridCellConfig<playerState, double>>& cellConfig) {
+	auto cellModel = cellConfig->cellModel;
+
+	if (cellModel == "player" && passiveCells) {
+		return std::make_shared<passivePlayer>(cellId, cellConfig, eventCounts);
+	} else if (cellModel == "player") {
+		return std::make_shared<player>(cellId, cellConfig, eventCounts);
+	} else {
+		throw std::bad_typeid();
+	}
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+		std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+		std::cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 500)] [--passive] [--events]" << std::endl;
+		return -1;
+	}
+	std::string configFilePath = argv[1];
+	double simTime = 500;
+	for (int i = 2; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--passive") {
+			passiveCells = true;
+		} else if (arg == "--events") {
+			eventCounts = std::make_shared<CellEventCounts>();
+		} else {
+			simTime = std::stod(arg);
+		}
+	}
+	auto start = std::chrono::steady_clock::now();
+
+    auto model = std::make_shared<GridCellDEVSCoupled<playerState, double>>("player", addGridCell, configFilePath);
+	model->buildModel();
+
+    auto rootCoordinator = RootCoordinator(model);
+	rootCoordinator.setLogger<CSVLogger>("grid_log.csv", ";");
+	
+	rootCoordinator.start();
+	rootCoordinator.simulate(simTime);
+	rootCoordinator.stop();
+
+	if (eventCounts) {
+		double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "transitions: " << eventCounts->transitions << ", rule evaluations: " << eventCounts->evaluations
+		          << ", outputs: " << eventCounts->outputs << ", wall time: " << milliseconds << " ms" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <csignal>
+#include <iostream>
+#include <string>
+#include "include/daemon/simulationDaemon.hpp"
+
+SimulationDaemon* daemonInstance = nullptr;
+
+void stopDaemon(int) {
+	if (daemonInstance != nullptr) {
+		daemonInstance->requestStop();
+	}
+}
+
+int main(int argc, char ** argv) {
+	std::string socketPath = "/tmp/football_player.sock";
+	unsigned workers = 1;
+	double maxTime = DEFAULT_MAX_JOB_TIME;
+	std::string logDir;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--socket" && i + 1 < argc) {
+			socketPath = argv[++i];
+		} else if (arg == "--workers" && i + 1 < argc) {
+			workers = std::stoul(argv[++i]);
+		} else if (arg == "--max-time" && i + 1 < argc) {
+			maxTime = std::stod(argv[++i]);
+		} else if (arg == "--log-dir" && i + 1 < argc) {
+			logDir = argv[++i];
+		} else {
+			std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+			std::cout << argv[0] << " [--socket PATH (default: /tmp/football_player.sock)] [--workers N (default: 1)] [--max-time T (default: 10000)] [--log-dir DIR (default: none, jobs cannot log)]" << std::endl;
+			return -1;
+		}
+	}
+
+	SimulationDaemon daemon(socketPath, workers, 8, maxTime, logDir);
+	daemonInstance = &daemon;
+	std::signal(SIGINT, stopDaemon);
+	std::signal(SIGTERM, stopDaemon);
+	std::cout << "listening on " << socketPath << " with " << workers << " worker(s)" << std::endl;
+	daemon.serve();
+	daemonInstance = nullptr;
+}
@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "include/engine/cellCoordinator.hpp"
+#include "include/engine/entityEngine.hpp"
+#include "include/engine/fixedGridEngine.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/gridLogger.hpp"
+
+//! Runs an engine over the same time window as RootCoordinator::simulate and logs it in grid_log.csv
+template <typename Engine>
+void runEngine(Engine& engine, double simTime, std::optional<std::uint64_t> seed, unsigned threads) {
+	if (seed) {
+		engine.setSeed(*seed);
+	}
+
+	GridLogger logger("grid_log.csv", ";");
+	logger.logGrid(0, engine.getScenario(), engine.states());
+
+	// one step per time unit (transport delay of 1); the previous step is copied into a reused buffer
+	std::vector<playerState> before;
+	while (engine.time() <= simTime) {
+		before.assign(engine.states().begin(), engine.states().end());
+		if constexpr (requires { engine.step(threads); }) {
+			engine.step(threads);
+		} else {
+			engine.step();
+		}
+		logger.logChanges(engine.time() - 1, engine.getScenario(), before, engine.states());
+	}
+}
+
+//! Runs the event-driven Cell-DEVS coordinator (Cadmium semantics) and logs it in grid_log.csv
+void runCoordinator(const Scenario& scenario, double simTime, unsigned threads) {
+	GridLogger logger("grid_log.csv", ";");
+	CellCoordinator<PooledMessageStore> coordinator(scenario);
+	coordinator.setLogger(&logger);
+	coordinator.setThreads(threads);
+	coordinator.start();
+	coordinator.simulateUntil(simTime);
+}
+
+//! Runs the entity engine, logs it in grid_log.csv and writes the position of every player and ball after every step in trajectories.csv
+void runEntities(const Scenario& scenario, double simTime, std::optional<std::uint64_t> seed) {
+	EntityEngine engine(scenario);
+	if (seed) {
+		engine.setSeed(*seed);
+	}
+
+	GridLogger logger("grid_log.csv", ";");
+	logger.logGrid(0, scenario, engine.states());
+
+	std::ofstream trajectories("trajectories.csv");
+	trajectories << "step;id;kind;row;col;in_flight\n";
+	auto logEntities = [&](long step) {
+		for (const Entity& entity: engine.getEntities()) {
+			trajectories << step << ";" << entity.id << ";" << (entity.kind == EntityKind::PLAYER ? "player" : "ball") << ";"
+			             << scenario.originRow + entity.row << ";" << scenario.originCol + entity.col << ";" << entity.inFlight << "\n";
+		}
+	};
+	logEntities(0);
+
+	// only the cells changed by a step are logged (same entries as runEngine)
+	while (engine.time() <= simTime) {
+		engine.step();
+		for (int i: engine.changedCells()) {
+			logger.logCell(engine.time() - 1, scenario, i, engine.cell(i / scenario.cols, i % scenario.cols));
+		}
+		logEntities(engine.time());
+	}
+}
+
+int main(int argc, char ** argv) {
+	if (argc < 2) {
+		std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+		std::cout << argv[0] << " SCENARIO_CONFIG.json [MAX_SIMULATION_TIME (default: 500)] [--seed SEED] [--threads N] [--coordinator | --entities]" << std::endl;
+		return -1;
+	}
+
+	std::string configFilePath = argv[1];
+	double simTime = 500;
+	std::optional<std::uint64_t> seed;
+	unsigned threads = 1;
+	bool coordinator = false;
+	bool entities = false;
+
+	for (int i = 2; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--seed" && i + 1 < argc) {
+			seed = std::stoull(argv[++i]);
+		} else if (arg == "--threads" && i + 1 < argc) {
+			threads = std::stoul(argv[++i]);
+		} else if (arg == "--coordinator") {
+			coordinator = true;
+		} else if (arg == "--entities") {
+			entities = true;
+		} else {
+			simTime = std::stod(arg);
+		}
+	}
+
+	Scenario scenario = loadScenario(configFilePath);
+	if (coordinator) {
+		if (seed) {
+			std::cerr << "--seed is not supported with --coordinator" << std::endl;
+			return -1;
+		}
+		runCoordinator(scenario, simTime, threads);
+		return 0;
+	}
+	if (entities) {
+		runEntities(scenario, simTime, seed);
+		return 0;
+	}
+
+	// small component/full grids (3x3, 10x10) run on the unrolled fixed-size engine
+	bool fixed = visitFixedGridEngine(scenario, [&](auto& engine) {
+		runEngine(engine, simTime, seed, threads);
+	});
+	if (!fixed) {
+		GridEngine engine(scenario);
+		runEngine(engine, simTime, seed, threads);
+	}
+}
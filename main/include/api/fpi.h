@@ -0,0 +1,81 @@
+#ifndef FPI_H
+#define FPI_H
+
+//! C API of the football player interaction simulation library (see simulation.hpp for the C++ API)
+//! Functions that can fail return NULL or -1 and set a message readable with fpi_last_error (per thread). Every function
+//! taking a simulation handle fails that way when the handle is NULL (except fpi_destroy, which ignores it).
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Cell state (the fields of playerState)
+//! action, direction, zone_type and player_role hold the numeric values of the Action, Direction, ZoneType and
+//! PlayerRole enumerations (same values as the JSON configuration and the CSV log)
+typedef struct fpi_cell_state {
+    bool has_player;
+    bool has_ball;
+    bool has_obstacle;
+    bool near_obstacle;
+    double mental;
+    double fatigue;
+    int action;
+    int direction;
+    int zone_type;
+    int player_role;
+    int initial_row;
+    int inactive_time;
+} fpi_cell_state;
+
+//! Simulation of one scenario (opaque)
+typedef struct fpi_simulation fpi_simulation;
+
+//! Loads a scenario JSON configuration (same format as football_player_interaction), NULL on error
+fpi_simulation* fpi_load(const char* config_path);
+
+//! Releases a simulation (NULL is ignored)
+void fpi_destroy(fpi_simulation* simulation);
+
+//! Message of the last error of the calling thread ("" if none)
+const char* fpi_last_error(void);
+
+//! Size of the grid (-1 on error)
+int fpi_rows(const fpi_simulation* simulation);
+int fpi_cols(const fpi_simulation* simulation);
+
+//! Number of steps computed so far (time of the next step, -1 on error)
+long fpi_time(const fpi_simulation* simulation);
+
+//! Computes the next steps (0 on success, -1 on error)
+int fpi_step(fpi_simulation* simulation, int steps);
+
+//! Read-only row-major copy of the rows x cols grid (cell (r, c) is at index r * cols + c), NULL on error
+//! The copy is refreshed by the first call after the grid changed. The pointer is valid until the next call to fpi_step,
+//! fpi_reset, fpi_set_cell or fpi_destroy (C++ code can read the grid without a copy with Simulation::grid)
+const fpi_cell_state* fpi_grid(const fpi_simulation* simulation);
+
+//! Replaces the state of a cell before the next step
+//! 0 on success, -1 if the cell is outside the grid or action, direction, zone_type or player_role is not a value of
+//! its enumeration (the grid is then left unchanged)
+int fpi_set_cell(fpi_simulation* simulation, int row, int col, const fpi_cell_state* state);
+
+//! Restores the initial grid of the scenario (time 0), 0 on success and -1 on error
+int fpi_reset(fpi_simulation* simulation);
+
+//! Enables the stochastic decision mode with a seed (0 on success, -1 on error)
+int fpi_set_seed(fpi_simulation* simulation, uint64_t seed);
+
+//! Returns to the deterministic rules (0 on success, -1 on error)
+int fpi_clear_seed(fpi_simulation* simulation);
+
+//! Number of threads used by fpi_step (0 on success, -1 on error)
+int fpi_set_threads(fpi_simulation* simulation, unsigned threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FPI_H
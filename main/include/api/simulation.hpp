@@ -0,0 +1,54 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include "../engine/gridEngine.hpp"
+#include "../engine/scenario.hpp"
+#include "../playerState.hpp"
+
+//! C++ API of the simulation library: a scenario that is stepped in-process, read between steps and modified
+//! by injecting cell states (e.g. a substituted player or a moved obstacle)
+class Simulation {
+    GridEngine engine;
+    unsigned threads;
+
+    public:
+    //! Loads a scenario JSON configuration (throws the exceptions of loadScenario)
+    explicit Simulation(const std::string& configFilePath);
+    explicit Simulation(Scenario scenario);
+
+    //! Computes the next steps
+    void step(int steps = 1);
+
+    //! Number of steps computed so far (time of the next step)
+    [[nodiscard]] long time() const;
+
+    [[nodiscard]] int rows() const;
+    [[nodiscard]] int cols() const;
+
+    //! Read-only row-major view of the grid (no copy, valid until the grid is stepped, reset or modified)
+    [[nodiscard]] std::span<const playerState> grid() const;
+
+    [[nodiscard]] const playerState& cell(int row, int col) const;
+
+    //! Replaces the state of a cell before the next step (throws std::out_of_range outside the grid and
+    //! std::invalid_argument if an enumeration field is out of range, without changing the grid)
+    void setCell(int row, int col, const playerState& state);
+
+    //! Restores the initial grid of the scenario
+    void reset();
+
+    //! Enables the stochastic decision mode
+    void setSeed(std::uint64_t seed);
+
+    //! Returns to the deterministic rules
+    void clearSeed();
+
+    void setThreads(unsigned n);
+
+    [[nodiscard]] const Scenario& getScenario() const;
+};
+
+#endif // SIMULATION_HPP
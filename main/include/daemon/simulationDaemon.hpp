@@ -0,0 +1,517 @@
+#ifndef SIMULATION_DAEMON_HPP
+#define SIMULATION_DAEMON_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+#include "../api/simulation.hpp"
+#include "../engine/gridLogger.hpp"
+#include "../engine/scenario.hpp"
+#include "../engine/stateHash.hpp"
+
+//! Largest "time" a job may ask for unless the daemon is given another limit (a job cannot be stopped once a worker
+//! runs it, so an unbounded time would hold that worker forever)
+constexpr double DEFAULT_MAX_JOB_TIME = 10000;
+
+//! Simulation job: one request line of the daemon protocol
+//! {"config": path, "time": t (default: 500), "seed": s (optional), "log": path (optional), "id": any (optional)}
+struct SimulationJob {
+    nlohmann::json id;                  // echoed in the reply (null if absent)
+    std::string config;                 // scenario configuration file
+    double simTime = 500;               // MAX_SIMULATION_TIME of football_player_interaction
+    std::optional<std::uint64_t> seed;  // stochastic mode seed
+    std::string log;                    // grid_log.csv path under the log directory (empty: only the summary is returned)
+};
+
+//! It parses a job request (throws std::invalid_argument if the config path is missing or the time is not in
+//! [0, maxSimTime])
+inline SimulationJob parseJob(const nlohmann::json& request, double maxSimTime = DEFAULT_MAX_JOB_TIME) {
+    SimulationJob job;
+    job.id = request.value("id", nlohmann::json());
+    if (!request.contains("config") || !request.at("config").is_string()) {
+        throw std::invalid_argument("the job has no \"config\" path");
+    }
+    job.config = request.at("config").get<std::string>();
+    job.simTime = request.value("time", 500.0);
+    if (!(job.simTime >= 0 && job.simTime <= maxSimTime)) {
+        throw std::invalid_argument("the job time " + nlohmann::json(job.simTime).dump() + " is out of range [0, " + nlohmann::json(maxSimTime).dump() + "]");
+    }
+    if (request.contains("seed")) {
+        job.seed = request.at("seed").get<std::uint64_t>();
+    }
+    job.log = request.value("log", "");
+    return job;
+}
+
+//! Path of a job log under the log directory of the daemon (throws std::invalid_argument if the daemon has no log
+//! directory, or if the log path is absolute or has a ".." component, since it could then point outside the directory)
+inline std::string resolveLogPath(const std::string& log, const std::string& logDirectory) {
+    if (log.empty()) {
+        return log;
+    }
+    if (logDirectory.empty()) {
+        throw std::invalid_argument("the daemon has no log directory, so jobs cannot ask for a log");
+    }
+    const std::filesystem::path name(log);
+    if (name.is_absolute() || std::find(name.begin(), name.end(), std::filesystem::path("..")) != name.end()) {
+        throw std::invalid_argument("the log path " + log + " must be relative to the log directory, without \"..\"");
+    }
+    return (std::filesystem::path(logDirectory) / name).string();
+}
+
+//! Outcome of a job
+struct JobSummary {
+    long steps = 0;                     // time steps computed
+    int players = 0;                    // players on the final grid
+    int balls = 0;                      // balls on the final grid
+    long changes = 0;                   // cell entries logged after the initial grid (0 without log)
+    std::uint64_t gridHash = 0;         // hashGrid of the final grid
+    bool warmScenario = false;          // the scenario was already parsed
+    bool warmGrid = false;              // the grid was already allocated (reset in place)
+    double milliseconds = 0.0;          // time spent by the worker on the job
+};
+
+inline nlohmann::json summaryToJson(const SimulationJob& job, const JobSummary& summary) {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(summary.gridHash));
+    nlohmann::json reply = {
+        {"id", job.id}, {"ok", true}, {"config", job.config}, {"steps", summary.steps}, {"players", summary.players},
+        {"balls", summary.balls}, {"changes", summary.changes}, {"grid_hash", hash}, {"warm_scenario", summary.warmScenario},
+        {"warm_grid", summary.warmGrid}, {"milliseconds", summary.milliseconds}
+    };
+    if (!job.log.empty()) {
+        reply["log"] = job.log;
+    }
+    return reply;
+}
+
+//! Parsed scenarios shared by the workers (a file is parsed again when its modification time changes)
+class ScenarioCache {
+    struct Entry {
+        std::filesystem::file_time_type modified;
+        std::shared_ptr<const Scenario> scenario;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+
+    public:
+    //! Scenario of a configuration file (warm: it was already parsed)
+    std::shared_ptr<const Scenario> get(const std::string& path, bool& warm) {
+        std::error_code error;
+        const auto modified = std::filesystem::last_write_time(path, error);
+        if (error) {
+            throw std::runtime_error("unable to open scenario file " + path);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(path);
+            if (it != entries.end() && it->second.modified == modified) {
+                warm = true;
+                return it->second.scenario;
+            }
+        }
+        // parsed outside the lock, so workers loading other scenarios are not held up
+        auto scenario = std::make_shared<const Scenario>(loadScenario(path));
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[path] = {modified, scenario};
+        warm = false;
+        return scenario;
+    }
+};
+
+//! Simulations of one worker, kept between jobs and reset in place (the least recently used one is dropped when
+//! there are more than capacity)
+class WarmGrids {
+    struct Entry {
+        std::shared_ptr<const Scenario> scenario;   // scenario the simulation was built from
+        std::unique_ptr<Simulation> simulation;
+        long lastUse;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    std::size_t capacity;
+    long uses;
+
+    public:
+    explicit WarmGrids(std::size_t maxGrids = 8): capacity(std::max<std::size_t>(maxGrids, 1)), uses(0) {}
+
+    //! Simulation of a scenario, reset to its initial grid (warm: it was already allocated)
+    Simulation& get(const std::string& path, const std::shared_ptr<const Scenario>& scenario, bool& warm) {
+        auto it = entries.find(path);
+        warm = (it != entries.end() && it->second.scenario == scenario);
+        if (warm) {
+            it->second.simulation->reset();
+        } else {
+            if (it == entries.end() && entries.size() >= capacity) {
+                auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+                    return a.second.lastUse < b.second.lastUse;
+                });
+                entries.erase(oldest);
+            }
+            it = entries.insert_or_assign(path, Entry{scenario, std::make_unique<Simulation>(*scenario), 0}).first;
+        }
+        it->second.lastUse = ++uses;
+        return *it->second.simulation;
+    }
+};
+
+//! Runs a job (same time window and log entries as football_player_interaction)
+inline JobSummary runJob(const SimulationJob& job, ScenarioCache& scenarios, WarmGrids& grids) {
+    const auto start = std::chrono::steady_clock::now();
+    JobSummary summary;
+    auto scenario = scenarios.get(job.config, summary.warmScenario);
+    Simulation& simulation = grids.get(job.config, scenario, summary.warmGrid);
+    if (job.seed) {
+        simulation.setSeed(*job.seed);
+    } else {
+        simulation.clearSeed();
+    }
+
+    if (job.log.empty()) {
+        while (simulation.time() <= job.simTime) {
+            simulation.step();
+        }
+    } else {
+        GridLogger logger(job.log, ";");
+        logger.logGrid(0, *scenario, simulation.grid());
+        std::vector<playerState> before;
+        while (simulation.time() <= job.simTime) {
+            before.assign(simulation.grid().begin(), simulation.grid().end());
+            simulation.step();
+            for (int i = 0; i < scenario->size(); ++i) {
+                if (before[i] != simulation.grid()[i]) {
+                    logger.logCell(simulation.time() - 1, *scenario, i, simulation.grid()[i]);
+                    ++summary.changes;
+                }
+            }
+        }
+    }
+
+    summary.steps = simulation.time();
+    for (const auto& state: simulation.grid()) {
+        summary.players += state.has_player ? 1 : 0;
+        summary.balls += state.has_ball ? 1 : 0;
+    }
+    summary.gridHash = hashGrid(simulation.grid());
+    summary.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+//! Sends a whole buffer on a socket (false if the peer is gone)
+inline bool sendAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+//! Reads newline-terminated lines from a socket
+class LineReader {
+    int fd;
+    std::string buffer;
+
+    public:
+    static constexpr std::size_t MAX_LINE = 1 << 20;
+
+    explicit LineReader(int socket): fd(socket) {}
+
+    //! Next line without its newline (std::nullopt when the peer closed the connection)
+    std::optional<std::string> next() {
+        while (true) {
+            std::size_t end = buffer.find('\n');
+            if (end != std::string::npos) {
+                std::string line = buffer.substr(0, end);
+                buffer.erase(0, end + 1);
+                return line;
+            }
+            if (buffer.size() > MAX_LINE) {
+                return std::nullopt;
+            }
+            char chunk[4096];
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return std::nullopt;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(n));
+        }
+    }
+};
+
+//! Unix domain socket address of a path (throws std::invalid_argument if the path is too long)
+inline sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("socket path is too long: " + path);
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+//! Local simulation job server on a Unix domain socket
+//! Clients send one JSON job per line (see SimulationJob) and get one JSON reply per job, in completion order (the
+//! reply echoes the job id): the summary of the run, or {"ok": false, "error": message}. {"command": "shutdown"}
+//! stops the daemon. Jobs longer than the time limit of the daemon are rejected. Jobs are run by a pool of workers. Parsed scenarios are shared by the workers, and every worker
+//! keeps the grids of its last scenarios allocated and resets them in place, so a repeated job neither parses JSON
+//! nor allocates a grid. Relative config paths are resolved from the working directory of the daemon, and log paths
+//! from its log directory (see resolveLogPath; without a log directory, jobs with a log are rejected).
+//! Trust model: any process that can connect to the socket (its file permissions decide which) can make the daemon
+//! read any file its user can read as a configuration, and use the workers up to the time limit. The log directory
+//! bounds where it writes, as long as no one else can create symbolic links in it.
+class SimulationDaemon {
+    //! Client connection (closed once the client is gone and every reply was sent)
+    struct Connection {
+        int fd;
+        std::mutex writeMutex;
+
+        explicit Connection(int socket): fd(socket) {}
+        ~Connection() {
+            ::close(fd);
+        }
+
+        void reply(const nlohmann::json& message) {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            sendAll(fd, message.dump() + "\n");
+        }
+    };
+
+    struct Task {
+        SimulationJob job;
+        std::shared_ptr<Connection> connection;
+    };
+
+    //! Request reader of a connection (joined on the next accept once it has returned)
+    struct Reader {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    std::string socketPath;
+    int listenFd;
+    unsigned workerCount;
+    std::size_t gridsPerWorker;
+    double maxJobTime;
+    std::string logDirectory;
+    ScenarioCache scenarios;
+    std::atomic<bool> stopping;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<Task> queue;
+    bool draining;                      // workers stop once the queue is empty
+
+    std::mutex connectionsMutex;
+    std::vector<std::weak_ptr<Connection>> connections;
+    std::vector<Reader> readers;
+
+    void workerLoop() {
+        WarmGrids grids(gridsPerWorker);
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueReady.wait(lock, [this]() { return draining || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            try {
+                task.connection->reply(summaryToJson(task.job, runJob(task.job, scenarios, grids)));
+            } catch (const std::exception& e) {
+                task.connection->reply({{"id", task.job.id}, {"ok", false}, {"error", e.what()}});
+            }
+        }
+    }
+
+    void readerLoop(std::shared_ptr<Connection> connection) {
+        LineReader reader(connection->fd);
+        while (auto line = reader.next()) {
+            if (line->empty()) {
+                continue;
+            }
+            nlohmann::json request;
+            try {
+                request = nlohmann::json::parse(*line);
+                if (request.value("command", "") == "shutdown") {
+                    connection->reply({{"ok", true}});
+                    requestStop();
+                    return;
+                }
+                Task task{parseJob(request, maxJobTime), connection};
+                task.job.log = resolveLogPath(task.job.log, logDirectory);
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queue.push_back(std::move(task));
+            } catch (const std::exception& e) {
+                connection->reply({{"id", request.is_object() ? request.value("id", nlohmann::json()) : nlohmann::json()}, {"ok", false}, {"error", e.what()}});
+                continue;
+            }
+            queueReady.notify_one();
+        }
+    }
+
+    public:
+    //! Binds the socket (a stale socket file is replaced) and throws std::runtime_error if it cannot listen
+    //! (logDir: directory of the job logs, empty to reject jobs with a log)
+    SimulationDaemon(std::string path, unsigned workers, std::size_t maxGridsPerWorker = 8, double maxTime = DEFAULT_MAX_JOB_TIME,
+                     std::string logDir = ""):
+        socketPath(std::move(path)), listenFd(-1), workerCount(std::max(workers, 1u)), gridsPerWorker(maxGridsPerWorker),
+        maxJobTime(maxTime), logDirectory(std::move(logDir)), stopping(false), draining(false) {
+        const sockaddr_un address = socketAddress(socketPath);
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            throw std::runtime_error(std::string("unable to create socket: ") + std::strerror(errno));
+        }
+        ::unlink(socketPath.c_str());
+        if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listenFd, 64) < 0) {
+            std::string message = std::string("unable to listen on ") + socketPath + ": " + std::strerror(errno);
+            ::close(listenFd);
+            throw std::runtime_error(message);
+        }
+    }
+
+    SimulationDaemon(const SimulationDaemon&) = delete;
+    SimulationDaemon& operator=(const SimulationDaemon&) = delete;
+
+    ~SimulationDaemon() {
+        ::close(listenFd);
+        ::unlink(socketPath.c_str());
+    }
+
+    //! Asks serve to return (async-signal-safe: it only sets a flag, checked every 100 ms)
+    void requestStop() noexcept {
+        stopping.store(true);
+    }
+
+    //! Accepts connections and runs jobs until requestStop (the queued jobs are completed before returning)
+    void serve() {
+        std::vector<std::thread> workers;
+        for (unsigned w = 0; w < workerCount; ++w) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+
+        while (!stopping.load()) {
+            pollfd listener{listenFd, POLLIN, 0};
+            if (::poll(&listener, 1, 100) <= 0) {
+                continue;
+            }
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            auto connection = std::make_shared<Connection>(fd);
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            std::erase_if(connections, [](const auto& c) { return c.expired(); });
+            connections.push_back(connection);
+            std::erase_if(readers, [](Reader& reader) {
+                if (!reader.finished->load()) {
+                    return false;
+                }
+                reader.thread.join();
+                return true;
+            });
+            auto finished = std::make_shared<std::atomic<bool>>(false);
+            readers.push_back({std::thread([this, connection, finished]() {
+                readerLoop(connection);
+                finished->store(true);
+            }), finished});
+        }
+
+        // stop reading requests, then let the workers finish the queue
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            for (const auto& weak: connections) {
+                if (auto connection = weak.lock()) {
+                    ::shutdown(connection->fd, SHUT_RD);
+                }
+            }
+        }
+        for (auto& reader: readers) {
+            reader.thread.join();
+        }
+        readers.clear();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            draining = true;
+        }
+        queueReady.notify_all();
+        for (auto& worker: workers) {
+            worker.join();
+        }
+    }
+};
+
+//! Blocking client of SimulationDaemon (one request at a time)
+class DaemonClient {
+    int fd;
+    std::unique_ptr<LineReader> reader;
+
+    public:
+    //! Connects to a daemon socket (throws std::runtime_error if no daemon listens on it)
+    explicit DaemonClient(const std::string& socketPath): fd(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        const sockaddr_un address = socketAddress(socketPath);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+            std::string message = std::string("unable to connect to ") + socketPath + ": " + std::strerror(errno);
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            throw std::runtime_error(message);
+        }
+        reader = std::make_unique<LineReader>(fd);
+    }
+
+    DaemonClient(const DaemonClient&) = delete;
+    DaemonClient& operator=(const DaemonClient&) = delete;
+
+    ~DaemonClient() {
+        ::close(fd);
+    }
+
+    //! Sends a request and waits for its reply (throws std::runtime_error if the daemon is gone)
+    nlohmann::json request(const nlohmann::json& message) {
+        std::optional<std::string> line;
+        if (sendAll(fd, message.dump() + "\n")) {
+            line = reader->next();
+        }
+        if (!line) {
+            throw std::runtime_error("the daemon closed the connection");
+        }
+        return nlohmann::json::parse(*line);
+    }
+};
+
+#endif // SIMULATION_DAEMON_HPP
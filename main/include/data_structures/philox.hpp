@@ -0,0 +1,68 @@
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+#include <array>
+#include <cstdint>
+
+//! Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+//! The output is a pure function of (counter, key): no generator state is shared between cells or threads
+struct Philox4x32 {
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr std::uint32_t WEYL_0 = 0x9E3779B9;      // golden ratio
+    static constexpr std::uint32_t WEYL_1 = 0xBB67AE85;      // sqrt(3) - 1
+    static constexpr int ROUNDS = 10;
+
+    [[nodiscard]] static constexpr Counter generate(Counter counter, Key key) {
+        for (int round = 0; round < ROUNDS; ++round) {
+            const std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * counter[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * counter[2];
+
+            counter = {
+                static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product0)
+            };
+
+            key[0] += WEYL_0;
+            key[1] += WEYL_1;
+        }
+        return counter;
+    }
+
+    //! Maps 32 random bits to a double in [0, 1)
+    [[nodiscard]] static constexpr double toUnit(std::uint32_t bits) {
+        return static_cast<double>(bits) * (1.0 / 4294967296.0);
+    }
+};
+
+//! Random stream of one cell evaluation, keyed on (seed, row, column, time step)
+class DecisionSampler {
+    Philox4x32::Key key;
+    Philox4x32::Counter counter;
+    Philox4x32::Counter block;
+    int used;   // number of values consumed from the current block
+
+    public:
+    DecisionSampler(std::uint64_t seed, int row, int col, std::uint64_t step):
+        key({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}),
+        counter({static_cast<std::uint32_t>(row), static_cast<std::uint32_t>(col), static_cast<std::uint32_t>(step), 0}),
+        block(),
+        used(4) {}
+
+    //! Returns the next uniform value in [0, 1) of this evaluation's stream
+    double uniform() {
+        if (used == 4) {
+            block = Philox4x32::generate(counter, key);
+            counter[3] += 1;    // next block of the same (row, col, step) stream
+            used = 0;
+        }
+        return Philox4x32::toUnit(block[used++]);
+    }
+};
+
+#endif // PHILOX_HPP
@@ -0,0 +1,222 @@
+#ifndef CELL_COORDINATOR_HPP
+#define CELL_COORDINATOR_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include "cellModel.hpp"
+#include "gridLogger.hpp"
+#include "messageStore.hpp"
+#include "scenario.hpp"
+#include "threadPool.hpp"
+
+//! Event counters of a coordinator run
+struct CoordinatorStatistics {
+    long instants = 0;          // simulation times with at least one event
+    long outputs = 0;           // outputs delivered to the neighborhoods
+    long transitions = 0;       // localComputation calls
+    long changes = 0;           // transitions that changed the cell state
+};
+
+//! Event-driven Cell-DEVS coordinator with Cadmium's grid semantics: every cell starts by outputting its initial
+//! state at time 0, a cell is re-evaluated when one of its neighbors (itself included) outputs, and a state change is
+//! output after CellModel::outputDelay with the scenario delay type (transport queues every change, inertial keeps
+//! only the latest one). The Store decides how neighbor snapshots and delay-queue entries are allocated.
+//! With several threads, the transitions of an instant are computed concurrently (localComputation is const and only
+//! reads the neighbor outputs, which do not change during the transition phase) and then applied serially in cell
+//! order, so the outputs, the statistics and the log are the same as in a sequential run.
+template <typename Store>
+class CellCoordinator {
+    public:
+    using ModelFactory = std::function<std::shared_ptr<const CellModel>(int row, int col)>;
+
+    //! Smallest batch of transitions split between threads by default
+    //! Splitting n transitions of cost c over T threads saves about n * c * (1 - 1/T) and costs one pool dispatch d.
+    //! With c = 39 ns (player cell, generated 256x256 grid) and d = 4 us (2 threads) to 7 us (4 threads), that model
+    //! puts the break-even at about 205 to 240 transitions. These costs were taken on a one-core machine, where the
+    //! threads cannot run at the same time and no batch actually breaks even, so 256 is an estimate from that model,
+    //! not a measured break-even; pass minTransitions to setThreads to tune it on a multi-core host.
+    static constexpr int DEFAULT_MIN_PARALLEL_TRANSITIONS = 256;
+
+    private:
+    using Event = std::pair<double, int>;       // (output time, cell)
+
+    Scenario scenario;
+    NeighborhoodTopology topology;
+    std::vector<std::shared_ptr<const CellModel>> models;
+    std::vector<playerState> cellStates;        // internal state of every cell
+    Store store;
+    std::vector<Event> schedule;                // min-heap of the next output of every cell
+    std::vector<long> receivedAt;               // last instant each cell was marked as receiver
+    std::vector<playerState> nextStates;        // transitions of the current instant (same order as the receivers)
+    std::unique_ptr<ThreadPool> pool;           // transition phase workers (nullptr: sequential)
+    int minParallelTransitions;                 // smaller instants are computed by the calling thread only
+    double clock;
+    bool inertial;
+    GridLogger* logger;
+    CoordinatorStatistics statistics;
+
+    void scheduleOutput(double time, int cell) {
+        schedule.emplace_back(time, cell);
+        std::push_heap(schedule.begin(), schedule.end(), std::greater<Event>());
+    }
+
+    void logCell(double time, int cell) {
+        if (logger != nullptr) {
+            logger->logCell(static_cast<long>(time), scenario, cell, cellStates[cell]);
+        }
+    }
+
+    //! Output phase: imminent cells send their output to their influencees (collected in receivers)
+    void sendOutputs(double time, std::pmr::vector<int>& receivers) {
+        const long instant = statistics.instants;
+        while (!schedule.empty() && schedule.front().first == time) {
+            const int cell = schedule.front().second;
+            std::pop_heap(schedule.begin(), schedule.end(), std::greater<Event>());
+            schedule.pop_back();
+
+            auto next = store.nextTime(cell);
+            if (!next || *next != time) continue;   // stale entry (the output was rescheduled or already sent)
+            while (next && *next == time) {
+                store.deliver(cell);
+                ++statistics.outputs;
+                next = store.nextTime(cell);
+            }
+            if (next) {
+                scheduleOutput(*next, cell);
+            }
+
+            for (const auto& [influencee, position]: topology.influencees[cell]) {
+                if (receivedAt[influencee] != instant) {
+                    receivedAt[influencee] = instant;
+                    receivers.push_back(influencee);
+                }
+            }
+        }
+        std::sort(receivers.begin(), receivers.end());
+    }
+
+    //! Computes the next state of receivers [first, last)
+    void evaluate(const std::pmr::vector<int>& receivers, int first, int last) {
+        for (int i = first; i < last; ++i) {
+            const int cell = receivers[i];
+            const int row = scenario.originRow + cell / scenario.cols;
+            const int col = scenario.originCol + cell % scenario.cols;
+            nextStates[i] = models[cell]->localComputation(cellStates[cell], store.neighbors(cell), row, col);
+        }
+    }
+
+    //! Transition phase: receivers compute their next state from the outputs of their neighbors
+    void computeTransitions(double time, const std::pmr::vector<int>& receivers) {
+        const int count = static_cast<int>(receivers.size());
+        if (pool && count >= minParallelTransitions) {
+            pool->parallelFor(count, [&](int first, int last) { evaluate(receivers, first, last); });
+        } else {
+            evaluate(receivers, 0, count);
+        }
+        statistics.transitions += count;
+
+        // state changes are applied (queued, scheduled and logged) serially in cell order
+        for (int i = 0; i < count; ++i) {
+            const int cell = receivers[i];
+            const playerState& next = nextStates[i];
+            if (next != cellStates[cell]) {
+                cellStates[cell] = next;
+                ++statistics.changes;
+                double outputTime = time + models[cell]->outputDelay(next);
+                if (store.push(cell, outputTime, next, inertial)) {
+                    scheduleOutput(outputTime, cell);
+                }
+                logCell(time, cell);
+            }
+        }
+    }
+
+    void processNextInstant() {
+        const double time = schedule.front().first;
+        ++statistics.instants;
+        {
+            std::pmr::vector<int> receivers(store.stepResource());
+            receivers.reserve(scenario.size());     // one allocation: every cell may receive
+            sendOutputs(time, receivers);
+            computeTransitions(time, receivers);
+        }
+        store.endStep();    // per-step scratch memory is recycled once the receivers are gone
+        clock = time;
+    }
+
+    public:
+    explicit CellCoordinator(Scenario s, const ModelFactory& factory = nullptr):
+        scenario(std::move(s)),
+        topology(buildTopology(scenario)),
+        minParallelTransitions(0),
+        clock(0.0),
+        inertial(scenario.delay == "inertial"),
+        logger(nullptr) {
+        auto player = std::make_shared<const PlayerCellModel>();
+        for (int cell = 0; cell < scenario.size(); ++cell) {
+            models.push_back(factory ? factory(scenario.originRow + cell / scenario.cols, scenario.originCol + cell % scenario.cols) : player);
+        }
+        schedule.reserve(2 * scenario.size());
+        nextStates.resize(scenario.size());
+    }
+
+    void setLogger(GridLogger* gridLogger) {
+        logger = gridLogger;
+    }
+
+    //! Number of threads of the transition phase (1: sequential) and smallest batch of transitions worth splitting
+    void setThreads(unsigned threads, int minTransitions = DEFAULT_MIN_PARALLEL_TRANSITIONS) {
+        pool = (threads > 1) ? std::make_unique<ThreadPool>(threads) : nullptr;
+        minParallelTransitions = minTransitions;
+    }
+
+    //! Initial state: every cell outputs its state at time 0
+    void start() {
+        cellStates = scenario.initial;
+        store.init(topology, cellStates);
+        schedule.clear();
+        receivedAt.assign(scenario.size(), 0);
+        statistics = {};
+        clock = 0.0;
+        for (int cell = 0; cell < scenario.size(); ++cell) {
+            store.push(cell, 0.0, cellStates[cell], inertial);
+            scheduleOutput(0.0, cell);
+            logCell(0.0, cell);
+        }
+    }
+
+    //! Processes every event up to (and including) timeFinal
+    void simulateUntil(double timeFinal) {
+        while (!schedule.empty() && schedule.front().first <= timeFinal) {
+            processNextInstant();
+        }
+    }
+
+    //! Time of the next event (infinity if every cell is passive)
+    [[nodiscard]] double nextTime() const {
+        return schedule.empty() ? std::numeric_limits<double>::infinity() : schedule.front().first;
+    }
+
+    [[nodiscard]] double time() const {
+        return clock;
+    }
+
+    [[nodiscard]] const std::vector<playerState>& states() const {
+        return cellStates;
+    }
+
+    [[nodiscard]] const Scenario& getScenario() const {
+        return scenario;
+    }
+
+    [[nodiscard]] const CoordinatorStatistics& getStatistics() const {
+        return statistics;
+    }
+};
+
+#endif // CELL_COORDINATOR_HPP
@@ -0,0 +1,52 @@
+#ifndef CELL_MODEL_HPP
+#define CELL_MODEL_HPP
+
+#include <atomic>
+#include "../playerState.hpp"
+#include "../playerRules.hpp"
+
+//! Cell model run by the cell coordinator (same two functions as Cadmium's GridCell)
+class CellModel {
+    public:
+    virtual ~CellModel() = default;
+
+    //! Computes the next state of the cell at (row, col) from its neighbor states
+    [[nodiscard]] virtual playerState localComputation(playerState state, const NeighborStates& neighbors, int row, int col) const = 0;
+
+    //! Delay between a state change and its output to the neighbors
+    [[nodiscard]] virtual double outputDelay(const playerState& state) const = 0;
+};
+
+//! Player cell (see player in playerCell.hpp)
+class PlayerCellModel : public CellModel {
+    public:
+    [[nodiscard]] playerState localComputation(playerState state, const NeighborStates& neighbors, int row, int /*col*/) const override {
+        return playerTransition(state, neighbors, row);
+    }
+
+    [[nodiscard]] double outputDelay(const playerState& /*state*/) const override {
+        return 1.0;
+    }
+};
+
+//! Passive player cell (see passivePlayer in playerCell.hpp): it keeps its state without running the rules while
+//! isPassive holds, so it has no output to schedule until a neighbor output wakes it up
+class PassivePlayerCellModel : public PlayerCellModel {
+    mutable std::atomic<long> evaluations{0};   // transitions that ran the rules (from several threads in parallel mode)
+
+    public:
+    [[nodiscard]] playerState localComputation(playerState state, const NeighborStates& neighbors, int row, int col) const override {
+        if (isPassive(state, neighbors)) {
+            return state;
+        }
+        evaluations.fetch_add(1, std::memory_order_relaxed);
+        return PlayerCellModel::localComputation(state, neighbors, row, col);
+    }
+
+    //! Transitions that ran the player rules so far (the others found the cell passive)
+    [[nodiscard]] long ruleEvaluations() const {
+        return evaluations.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // CELL_MODEL_HPP
@@ -0,0 +1,299 @@
+#ifndef ENTITY_ENGINE_HPP
+#define ENTITY_ENGINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+#include "../data_structures/philox.hpp"
+
+enum class EntityKind { PLAYER, BALL };
+
+//! Player or ball tracked by EntityEngine
+struct Entity {
+    int id;             // stable identifier (kept while the entity moves, never reused)
+    EntityKind kind;
+    int row;            // grid row of the cell holding it (the cell it left while it is in flight)
+    int col;
+    bool inFlight;      // left its cell during the last step (dribble, move or pass) and lands during the next one
+};
+
+//! Synchronous stepper of the player grid driven by its players (same states as GridEngine)
+//! Only the cells that differ from the default cell state are stored, in a hash map keyed on the cell index, and a
+//! step only evaluates the player cells, the cells that changed during the last step and their direct neighbors:
+//! an empty default cell only reacts to its direct neighbors, and a cell whose neighborhood did not change computes
+//! the same state again. The work per step follows the number of players and moving cells, not the grid size.
+//! Players and balls are also kept as an entity list with stable ids. The rules move them by copying attributes
+//! into the target cell, so an entity keeps its id when a cell picks it up from the neighbor the rules inherit
+//! from (a player's role stays with the cell it left, as in the grid rules). Entities the rules drop (two players
+//! moving into the same cell, a pass to a cell left empty) end there, and players or balls the rules duplicate get
+//! a new id.
+class EntityEngine {
+    Scenario scenario;                                  // scenario without its initial grid
+    playerState background;                             // state of every cell missing from the hash map
+    std::vector<std::pair<int, playerState>> initialCells;  // initial cells that differ from the background
+    std::unordered_map<int, playerState> cells;         // spatial hash: cell index -> state (non-background cells)
+    std::vector<int> changed;                           // cells changed by the last step (sorted)
+    std::vector<Entity> entities;                       // live players and balls (sorted by id)
+    std::vector<std::pair<int, playerState>> updates;   // scratch: cells changed by the current step
+    std::vector<int> evaluated;                         // scratch: cells evaluated by the current step
+    int nextId;
+    long steps;
+    std::optional<std::uint64_t> seed;
+
+    [[nodiscard]] const playerState& stateAt(int i) const {
+        auto it = cells.find(i);
+        return (it == cells.end()) ? background : it->second;
+    }
+
+    //! State of a cell after the current step (updates must be sorted)
+    [[nodiscard]] const playerState& nextStateAt(int i) const {
+        auto it = std::lower_bound(updates.begin(), updates.end(), i, [](const auto& update, int index) { return update.first < index; });
+        return (it != updates.end() && it->first == i) ? it->second : stateAt(i);
+    }
+
+    [[nodiscard]] NeighborStates gatherNeighbors(int row, int col) const {
+        NeighborStates neighbors{};
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            int n = scenario.neighborIndex(row, col, slot);
+            neighbors[slot] = (n < 0) ? nullptr : &stateAt(n);
+        }
+        return neighbors;
+    }
+
+    //! Adds a cell and its direct neighbors to the evaluated cells
+    void addWithNeighbors(int i) {
+        const int row = i / scenario.cols;
+        const int col = i % scenario.cols;
+        evaluated.push_back(i);
+        for (int slot: {NORTH_SLOT, WEST_SLOT, EAST_SLOT, SOUTH_SLOT}) {
+            int n = scenario.neighborIndex(row, col, slot);
+            if (n >= 0) {
+                evaluated.push_back(n);
+            }
+        }
+    }
+
+    //! Neighbor of cell i whose action slot targets it (-1 if none)
+    [[nodiscard]] int actingNeighbor(int i, int slot, Action action, Direction direction) const {
+        int n = scenario.neighborIndex(i / scenario.cols, i % scenario.cols, slot);
+        return (n >= 0 && isActionFromDirection(stateAt(n), action, direction)) ? n : -1;
+    }
+
+    //! Cell a player landing on empty cell i comes from: the last dribbling or moving neighbor in north, west, east,
+    //! south order (the one collectActionFlags inherits the attributes from)
+    [[nodiscard]] int playerSource(int i, bool dribbleOnly) const {
+        constexpr std::array<std::pair<int, Direction>, 4> towards = {{
+            {NORTH_SLOT, Direction::SOUTH}, {WEST_SLOT, Direction::EAST}, {EAST_SLOT, Direction::WEST}, {SOUTH_SLOT, Direction::NORTH}
+        }};
+        int source = -1;
+        for (const auto& [slot, direction]: towards) {
+            int n = actingNeighbor(i, slot, Action::DRIBBLE, direction);
+            if (n < 0 && !dribbleOnly) {
+                n = actingNeighbor(i, slot, Action::MOVE, direction);
+            }
+            source = (n >= 0) ? n : source;
+        }
+        return source;
+    }
+
+    //! Cell a ball received by player cell i comes from (same priority as the receive rules)
+    [[nodiscard]] int passSource(int i) const {
+        for (const auto& [slot, action, direction]: {
+                std::tuple{WEST_SLOT, Action::SHORT_PASS, Direction::EAST}, std::tuple{EAST_SLOT, Action::SHORT_PASS, Direction::WEST},
+                std::tuple{NORTH_SLOT, Action::LONG_PASS, Direction::SOUTH}, std::tuple{SOUTH_SLOT, Action::LONG_PASS, Direction::NORTH},
+                std::tuple{NORTH_EXTENDED_SLOT, Action::LONG_PASS, Direction::SOUTH}, std::tuple{SOUTH_EXTENDED_SLOT, Action::LONG_PASS, Direction::NORTH}}) {
+            int n = actingNeighbor(i, slot, action, direction);
+            if (n >= 0) {
+                return n;
+            }
+        }
+        return -1;
+    }
+
+    //! Moves the entities along the changes of the current step (reads the states before the step)
+    void trackEntities() {
+        // entities that left a cell during the last step, keyed by that cell
+        std::unordered_map<int, std::size_t> playerFlights, ballFlights;
+        std::vector<Entity> next;
+        next.reserve(entities.size());
+        for (std::size_t e = 0; e < entities.size(); ++e) {
+            Entity entity = entities[e];
+            const int i = scenario.index(entity.row, entity.col);
+            if (entity.inFlight) {
+                (entity.kind == EntityKind::PLAYER ? playerFlights : ballFlights)[i] = e;
+                continue;
+            }
+            const playerState& after = nextStateAt(i);
+            entity.inFlight = (entity.kind == EntityKind::PLAYER) ? !after.has_player : !after.has_ball;
+            next.push_back(entity);
+        }
+
+        std::vector<bool> claimed(entities.size(), false);
+        auto idFrom = [&](const std::unordered_map<int, std::size_t>& flights, int source) {
+            auto it = (source < 0) ? flights.end() : flights.find(source);
+            if (it == flights.end() || claimed[it->second]) {
+                return nextId++;    // created (or duplicated) by the rules
+            }
+            claimed[it->second] = true;
+            return entities[it->second].id;
+        };
+
+        for (const auto& [i, after]: updates) {
+            const playerState& before = stateAt(i);
+            const int row = i / scenario.cols;
+            const int col = i % scenario.cols;
+            if (after.has_player && !before.has_player) {
+                next.push_back({idFrom(playerFlights, playerSource(i, false)), EntityKind::PLAYER, row, col, false});
+            }
+            if (after.has_ball && !before.has_ball) {
+                int source = before.has_player ? passSource(i) : playerSource(i, true);
+                next.push_back({idFrom(ballFlights, source), EntityKind::BALL, row, col, false});
+            }
+        }
+
+        std::sort(next.begin(), next.end(), [](const Entity& a, const Entity& b) { return a.id < b.id; });
+        entities.swap(next);
+    }
+
+    public:
+    //! Throws std::invalid_argument if the default cell is not an empty cell at rest (see isQuiet)
+    explicit EntityEngine(Scenario s): scenario(std::move(s)), background(scenario.defaultState), nextId(0), steps(0) {
+        if (!isQuiet(background)) {
+            throw std::invalid_argument("the entity engine needs an empty default cell without pending action");
+        }
+        for (int i = 0; i < scenario.size(); ++i) {
+            if (scenario.initial[i] != background) {
+                initialCells.emplace_back(i, scenario.initial[i]);
+            }
+        }
+        scenario.initial.clear();
+        scenario.initial.shrink_to_fit();
+        reset();
+    }
+
+    //! Enables the stochastic decision mode
+    void setSeed(std::uint64_t s) {
+        seed = s;
+    }
+
+    //! Restores the initial state of the scenario (entities get new ids in row-major order)
+    void reset() {
+        cells.clear();
+        cells.insert(initialCells.begin(), initialCells.end());
+        changed.clear();
+        entities.clear();
+        nextId = 0;
+        steps = 0;
+        for (const auto& [i, state]: initialCells) {
+            const int row = i / scenario.cols;
+            const int col = i % scenario.cols;
+            if (state.has_player) {
+                entities.push_back({nextId++, EntityKind::PLAYER, row, col, false});
+            }
+            if (state.has_ball) {
+                entities.push_back({nextId++, EntityKind::BALL, row, col, false});
+            }
+        }
+    }
+
+    //! Computes the next time step
+    void step() {
+        evaluated.clear();
+        if (steps == 0) {
+            for (const auto& [i, state]: cells) {
+                addWithNeighbors(i);
+            }
+        } else {
+            for (const Entity& entity: entities) {
+                if (entity.kind == EntityKind::PLAYER && !entity.inFlight) {
+                    evaluated.push_back(scenario.index(entity.row, entity.col));
+                }
+            }
+            for (int i: changed) {
+                addWithNeighbors(i);
+            }
+        }
+        std::sort(evaluated.begin(), evaluated.end());
+        evaluated.erase(std::unique(evaluated.begin(), evaluated.end()), evaluated.end());
+
+        updates.clear();
+        for (int i: evaluated) {
+            const int row = i / scenario.cols;
+            const int col = i % scenario.cols;
+            const int cellRow = scenario.originRow + row;
+            std::optional<DecisionSampler> sampler;
+            if (seed) {
+                sampler.emplace(*seed, cellRow, scenario.originCol + col, steps);
+            }
+            const playerState& before = stateAt(i);
+            playerState after = playerTransition(before, gatherNeighbors(row, col), cellRow, sampler ? &*sampler : nullptr);
+            if (after != before) {
+                updates.emplace_back(i, after);
+            }
+        }
+
+        trackEntities();
+        changed.clear();
+        for (const auto& [i, after]: updates) {
+            if (after != background) {
+                cells[i] = after;
+            } else {
+                cells.erase(i);
+            }
+            changed.push_back(i);
+        }
+        ++steps;
+    }
+
+    [[nodiscard]] long time() const {
+        return steps;
+    }
+
+    //! State of a cell after the last step
+    [[nodiscard]] const playerState& cell(int row, int col) const {
+        return stateAt(scenario.index(row, col));
+    }
+
+    //! Row-major copy of the grid
+    [[nodiscard]] std::vector<playerState> states() const {
+        std::vector<playerState> grid(scenario.size(), background);
+        for (const auto& [i, state]: cells) {
+            grid[i] = state;
+        }
+        return grid;
+    }
+
+    //! Cells whose state changed during the last step (row-major order)
+    [[nodiscard]] const std::vector<int>& changedCells() const {
+        return changed;
+    }
+
+    //! Live players and balls after the last step (sorted by id)
+    [[nodiscard]] const std::vector<Entity>& getEntities() const {
+        return entities;
+    }
+
+    //! Number of cells evaluated by the last step
+    [[nodiscard]] int evaluatedCells() const {
+        return static_cast<int>(evaluated.size());
+    }
+
+    //! Number of cells stored in the hash map
+    [[nodiscard]] int storedCells() const {
+        return static_cast<int>(cells.size());
+    }
+
+    [[nodiscard]] const Scenario& getScenario() const {
+        return scenario;
+    }
+};
+
+#endif // ENTITY_ENGINE_HPP
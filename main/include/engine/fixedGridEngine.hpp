@@ -0,0 +1,145 @@
+#ifndef FIXED_GRID_ENGINE_HPP
+#define FIXED_GRID_ENGINE_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+#include "../data_structures/philox.hpp"
+
+//! Synchronous stepper for small grids whose shape and neighborhood range are known at compile time
+//! The grid lives in two std::array buffers, the neighbor table is constexpr and the step loop is unrolled
+//! (one stepCell<I> instantiation per cell), so a step has no loops, bounds checks or allocations left.
+//! It computes the same states as GridEngine for non wrapped scenarios of that shape.
+template <int Rows, int Cols, int Range>
+class FixedGridEngine {
+    public:
+    static constexpr int CELLS = Rows * Cols;
+    using Grid = std::array<playerState, CELLS>;
+
+    private:
+    //! Neighbor index of every (cell, slot) pair (-1 if it is outside the grid or the neighborhood)
+    static constexpr std::array<std::array<int, NEIGHBOR_SLOTS>, CELLS> neighborTable = []() {
+        std::array<std::array<int, NEIGHBOR_SLOTS>, CELLS> table{};
+        for (int i = 0; i < CELLS; ++i) {
+            for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+                int r = i / Cols + neighborOffsets[slot][0];
+                int c = i % Cols + neighborOffsets[slot][1];
+                bool outside = r < 0 || r >= Rows || c < 0 || c >= Cols;
+                bool outOfRange = slot >= NORTH_EXTENDED_SLOT && Range < 2;
+                table[i][slot] = (outside || outOfRange) ? -1 : r * Cols + c;
+            }
+        }
+        return table;
+    }();
+
+    Scenario scenario;
+    Grid initial;
+    std::array<Grid, 2> buffers;        // buffers[front] holds the last computed step
+    int front;
+    long steps;
+    std::optional<std::uint64_t> seed;
+
+    template <int I, int Slot>
+    [[nodiscard]] const playerState* neighbor(const Grid& grid) const {
+        if constexpr (neighborTable[I][Slot] < 0) {
+            return nullptr;
+        } else {
+            return &grid[neighborTable[I][Slot]];
+        }
+    }
+
+    template <int I>
+    void stepCell(const Grid& grid, Grid& nextGrid) {
+        const NeighborStates neighbors = {
+            neighbor<I, NORTH_SLOT>(grid),
+            neighbor<I, SOUTH_SLOT>(grid),
+            neighbor<I, EAST_SLOT>(grid),
+            neighbor<I, WEST_SLOT>(grid),
+            neighbor<I, NORTH_EXTENDED_SLOT>(grid),
+            neighbor<I, SOUTH_EXTENDED_SLOT>(grid)
+        };
+        const int cellRow = scenario.originRow + I / Cols;
+
+        if (seed) {
+            DecisionSampler sampler(*seed, cellRow, scenario.originCol + I % Cols, steps);
+            nextGrid[I] = playerTransition(grid[I], neighbors, cellRow, &sampler);
+        } else {
+            nextGrid[I] = playerTransition(grid[I], neighbors, cellRow);
+        }
+    }
+
+    template <std::size_t... I>
+    void stepCells(const Grid& grid, Grid& nextGrid, std::index_sequence<I...>) {
+        (stepCell<static_cast<int>(I)>(grid, nextGrid), ...);
+    }
+
+    public:
+    explicit FixedGridEngine(Scenario s): scenario(std::move(s)), front(0), steps(0) {
+        if (scenario.rows != Rows || scenario.cols != Cols || scenario.range != Range || scenario.wrapped) {
+            throw std::invalid_argument("scenario does not match the fixed grid engine shape");
+        }
+        std::copy(scenario.initial.begin(), scenario.initial.end(), initial.begin());
+        buffers[0] = initial;
+    }
+
+    //! Enables the stochastic decision mode
+    void setSeed(std::uint64_t s) {
+        seed = s;
+    }
+
+    //! Restores the initial state of the scenario
+    void reset() {
+        buffers[0] = initial;
+        front = 0;
+        steps = 0;
+    }
+
+    //! Computes the next time step
+    void step() {
+        stepCells(buffers[front], buffers[1 - front], std::make_index_sequence<CELLS>{});
+        front = 1 - front;
+        ++steps;
+    }
+
+    [[nodiscard]] long time() const {
+        return steps;
+    }
+
+    [[nodiscard]] const Grid& states() const {
+        return buffers[front];
+    }
+
+    [[nodiscard]] const Scenario& getScenario() const {
+        return scenario;
+    }
+};
+
+//! Calls visitor(engine) with the FixedGridEngine instantiation matching scenario.shape and range
+//! Returns false (without calling the visitor) if there is no instantiation for the scenario
+template <typename Visitor>
+bool visitFixedGridEngine(const Scenario& scenario, Visitor&& visitor) {
+    if (scenario.wrapped) {
+        return false;
+    }
+
+    auto visit = [&scenario, &visitor]<int Rows, int Cols, int Range>() {
+        if (scenario.rows != Rows || scenario.cols != Cols || scenario.range != Range) {
+            return false;
+        }
+        FixedGridEngine<Rows, Cols, Range> engine(scenario);
+        visitor(engine);
+        return true;
+    };
+
+    // component tests (3x3) and full simulations (10x10)
+    return visit.template operator()<3, 3, 1>()
+        || visit.template operator()<3, 3, 2>()
+        || visit.template operator()<10, 10, 1>()
+        || visit.template operator()<10, 10, 2>();
+}
+
+#endif // FIXED_GRID_ENGINE_HPP
@@ -0,0 +1,345 @@
+#ifndef GRID_ENGINE_HPP
+#define GRID_ENGINE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+#include "obstacleField.hpp"
+#include "occupancyBitboard.hpp"
+#include "scenario.hpp"
+#include "threadPool.hpp"
+#include "../playerRules.hpp"
+#include "../data_structures/philox.hpp"
+
+//! Synchronous stepper of the player grid (no Cadmium coordinator)
+//! Step t computes every cell from the states of step t-1 with the rules of playerRules.hpp, which the Cadmium cell
+//! shares. With a transport delay of 1 this is the Cell-DEVS schedule (a cell whose neighborhood did not change would
+//! compute the same state again), but its logs have not been compared against a Cadmium run.
+//! In stochastic mode every cell draws from its own counter-based stream keyed on (seed, row, col, step), so no RNG
+//! state is shared and the result does not depend on the number of threads or the order cells are evaluated in.
+//! With bitboards enabled, the occupancy flags of a row come from OccupancyBitboard masks and only the action flags
+//! are read from the neighbor states.
+//! With the obstacle field enabled, the obstacle flags come from ObstacleField and obstacle cells at their fixed
+//! point are not evaluated.
+//! With passivation enabled, a step only evaluates the cells woken by a change in their neighborhood during the
+//! previous step, like a Cell-DEVS cell that waits for a neighbor output: a cell whose neighborhood (itself included)
+//! did not change would compute the same state again. Player cells stay awake in stochastic mode, since their draws
+//! depend on the step.
+class GridEngine {
+    Scenario scenario;
+    std::vector<playerState> current;   // states after the last step
+    std::vector<playerState> next;      // states being computed
+    long steps;                         // number of steps computed so far (time of the next step)
+    std::optional<std::uint64_t> seed;  // stochastic mode seed
+    std::optional<OccupancyBitboard> bitboard;      // occupancy of current (bitboard mode)
+    std::optional<OccupancyBitboard> nextBitboard;  // occupancy of next, filled as the cells are computed
+    std::vector<RowMasks> rowMasks;     // row masks scratch of every thread (bitboard mode)
+    std::optional<ObstacleField> obstacles;         // static obstacle flags of current (obstacle field mode)
+    bool passivation;                   // only evaluate the awake cells
+    bool wakeAll;                       // the next step evaluates every cell (first step, seed changed)
+    std::vector<int> awake;             // cells evaluated by the next step (passivation mode)
+    std::vector<long> wokenAt;          // step each cell was last added to awake
+    std::vector<int> evaluated;         // cells evaluated by the last step (passivation mode, stochastic)
+    std::vector<std::vector<int>> changedBy;        // cells changed by every thread during the step
+    long evaluations;                   // cell evaluations since the last reset
+    std::unique_ptr<ThreadPool> pool;   // step workers, kept between steps (nullptr: sequential)
+
+    //! Calls part(t) for every part t in [0, parts) of a step, on the pool threads when there are several
+    //! (each part runs on a single thread, so it may use the scratch buffers of index t)
+    template <typename Part>
+    void runParts(unsigned threads, unsigned parts, const Part& part) {
+        if (threads <= 1 || parts <= 1) {
+            for (unsigned t = 0; t < parts; ++t) {
+                part(t);
+            }
+            return;
+        }
+        if (!pool || pool->size() != threads) {
+            pool = std::make_unique<ThreadPool>(threads);
+        }
+        pool->parallelFor(static_cast<int>(parts), [&part](int first, int last) {
+            for (int t = first; t < last; ++t) {
+                part(static_cast<unsigned>(t));
+            }
+        });
+    }
+
+    //! Computes the next state of a cell (bits: row mask word of the cell in bitboard mode)
+    void stepCell(int row, int col, const RowMasks::Word* bits) {
+        const int i = scenario.index(row, col);
+        if (obstacles && obstacles->isElided(i)) {
+            return;     // both buffers already hold its fixed point
+        }
+        const NeighborStates neighbors = scenario.gatherNeighbors(current, row, col);
+        const int cellRow = scenario.originRow + row;
+
+        std::optional<DecisionSampler> sampler;
+        if (seed) {
+            sampler.emplace(*seed, cellRow, scenario.originCol + col, steps);
+        }
+        DecisionSampler* samplerPtr = sampler ? &*sampler : nullptr;
+
+        if (bits != nullptr) {
+            playerState state = current[i];
+            NeighborFlags flags;
+            SourcePlayer source;
+            if (state.has_player) {
+                RowMasks::applyTo(*bits, col & 63, state, flags);
+            } else {
+                RowMasks::raiseNearObstacle(*bits, col & 63, state);
+            }
+            collectActionFlags(neighbors, flags, source);
+            next[i] = applyPlayerRules(state, flags, source, cellRow, samplerPtr);
+        } else if (obstacles) {
+            playerState state = current[i];
+            NeighborFlags flags;
+            SourcePlayer source;
+            if (state.has_player) {
+                collectVacancyFlags(neighbors, flags);
+                ObstacleField::applyTo((*obstacles)[i], state, flags);
+            } else {
+                ObstacleField::raiseNearObstacle((*obstacles)[i], state);
+            }
+            collectActionFlags(neighbors, flags, source);
+            next[i] = applyPlayerRules(state, flags, source, cellRow, samplerPtr);
+        } else {
+            next[i] = playerTransition(current[i], neighbors, cellRow, samplerPtr);
+        }
+    }
+
+    //! Computes rows [first, last) of the next grid
+    void stepRows(int first, int last, RowMasks* masks) {
+        for (int row = first; row < last; ++row) {
+            if (masks == nullptr) {
+                for (int col = 0; col < scenario.cols; ++col) {
+                    stepCell(row, col, nullptr);
+                }
+                continue;
+            }
+            bitboard->computeRowMasks(row, *masks);
+            for (int w = 0; w * 64 < scenario.cols; ++w) {
+                const RowMasks::Word bits = masks->word(w);
+                std::uint64_t player = 0, ball = 0, obstacle = 0, nearObstacle = 0;
+                for (int col = w * 64; col < std::min(scenario.cols, w * 64 + 64); ++col) {
+                    stepCell(row, col, &bits);
+                    const playerState& s = next[scenario.index(row, col)];
+                    const std::uint64_t bit = std::uint64_t{1} << (col & 63);
+                    player |= s.has_player ? bit : 0;
+                    ball |= s.has_ball ? bit : 0;
+                    obstacle |= s.has_obstacle ? bit : 0;
+                    nearObstacle |= s.near_obstacle ? bit : 0;
+                }
+                nextBitboard->storeWord(row, w, player, ball, obstacle, nearObstacle);
+            }
+        }
+    }
+
+    //! Computes the awake cells [first, last) of the next grid and records the ones that changed
+    void stepAwake(int first, int last, std::vector<int>& changed) {
+        for (int k = first; k < last; ++k) {
+            const int i = awake[k];
+            stepCell(i / scenario.cols, i % scenario.cols, nullptr);
+            if (next[i] != current[i]) {
+                changed.push_back(i);
+            }
+        }
+    }
+
+    //! Wakes a cell for the step computed at time `at`
+    void wake(int i, long at) {
+        if (wokenAt[i] != at) {
+            wokenAt[i] = at;
+            awake.push_back(i);
+        }
+    }
+
+    //! Wakes a cell and the cells that read it (the von Neumann neighborhood is symmetric, so they are its neighbors)
+    void wakeAround(int i, long at) {
+        const int row = i / scenario.cols;
+        const int col = i % scenario.cols;
+        wake(i, at);
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            int n = scenario.neighborIndex(row, col, slot);
+            if (n >= 0) {
+                wake(n, at);
+            }
+        }
+    }
+
+    //! Computes the next grid in passivation mode
+    void stepPassive(unsigned threads) {
+        if (changedBy.size() < threads) {
+            changedBy.resize(threads);
+        }
+        for (auto& changed: changedBy) {
+            changed.clear();
+        }
+
+        if (wakeAll) {
+            awake.resize(scenario.size());
+            for (int i = 0; i < scenario.size(); ++i) {
+                awake[i] = i;
+            }
+            wakeAll = false;
+        }
+        std::sort(awake.begin(), awake.end());
+        const int count = static_cast<int>(awake.size());
+        const unsigned parts = std::clamp<unsigned>(threads, 1, std::max(count, 1));
+        runParts(threads, parts, [this, count, parts](unsigned t) {
+            int first = static_cast<int>(static_cast<long>(count) * t / parts);
+            int last = static_cast<int>(static_cast<long>(count) * (t + 1) / parts);
+            stepAwake(first, last, changedBy[t]);
+        });
+        evaluations += count;
+
+        // the players evaluated by this step stay awake in stochastic mode
+        evaluated.clear();
+        if (seed) {
+            evaluated.swap(awake);
+        }
+        awake.clear();
+        for (const auto& changed: changedBy) {
+            for (int i: changed) {
+                wakeAround(i, steps + 1);
+            }
+        }
+        for (int i: evaluated) {
+            if (next[i].has_player) {
+                wake(i, steps + 1);
+            }
+        }
+    }
+
+    public:
+    explicit GridEngine(Scenario s): scenario(std::move(s)), current(scenario.initial), next(scenario.initial), steps(0),
+        passivation(false), wakeAll(true), evaluations(0) {}
+
+    //! Enables the stochastic decision mode
+    void setSeed(std::uint64_t s) {
+        seed = s;
+        wakeAll = true;
+    }
+
+    //! Returns to the deterministic rules
+    void clearSeed() {
+        seed.reset();
+        wakeAll = true;
+    }
+
+    //! Computes the occupancy flags from bitboard planes (see OccupancyBitboard)
+    //! Throws std::logic_error with passivation enabled (bitboard rows are computed whole)
+    void enableBitboards() {
+        if (passivation) {
+            throw std::logic_error("bitboards and passivation cannot be combined");
+        }
+        bitboard.emplace(scenario);
+        bitboard->build(current);
+        nextBitboard = bitboard;
+    }
+
+    //! Reads the obstacle flags from a precomputed field and skips the obstacle cells at their fixed point
+    //! (see ObstacleField)
+    void enableObstacleField() {
+        obstacles.emplace();
+        obstacles->build(scenario, current);
+    }
+
+    //! Only evaluates the cells whose neighborhood changed during the previous step (the first step evaluates every cell)
+    //! Throws std::logic_error with bitboards enabled
+    void enablePassivation() {
+        if (bitboard) {
+            throw std::logic_error("bitboards and passivation cannot be combined");
+        }
+        passivation = true;
+        wakeAll = true;
+        wokenAt.assign(scenario.size(), -1);
+    }
+
+    //! Restores the initial state of the scenario
+    void reset() {
+        current = scenario.initial;
+        steps = 0;
+        wakeAll = true;
+        evaluations = 0;
+        std::fill(wokenAt.begin(), wokenAt.end(), -1);
+        if (bitboard) {
+            bitboard->build(current);
+        }
+        if (obstacles) {
+            obstacles->build(scenario, current);
+        }
+    }
+
+    //! Replaces the state of a cell (the next step computes from it)
+    void setCell(int row, int col, const playerState& state) {
+        current[scenario.index(row, col)] = state;
+        if (bitboard) {
+            bitboard->update(row, col, state);
+        }
+        if (obstacles) {
+            obstacles->cellChanged(scenario, current, scenario.index(row, col));
+        }
+        if (passivation && !wakeAll) {
+            wakeAround(scenario.index(row, col), steps);
+        }
+    }
+
+    //! Computes the next time step (rows are split between threads, kept in a pool between steps)
+    void step(unsigned threads = 1) {
+        if (passivation) {
+            stepPassive(std::max(threads, 1u));
+            current.swap(next);
+            ++steps;
+            if (obstacles) {
+                obstacles->update(scenario, current, next);
+            }
+            return;
+        }
+
+        const unsigned parts = std::clamp<unsigned>(threads, 1, scenario.rows);
+        if (bitboard && rowMasks.size() < parts) {
+            rowMasks.resize(parts, RowMasks(bitboard->wordsPerRow()));
+        }
+        runParts(threads, parts, [this, parts](unsigned t) {
+            int first = static_cast<int>(static_cast<long>(scenario.rows) * t / parts);
+            int last = static_cast<int>(static_cast<long>(scenario.rows) * (t + 1) / parts);
+            stepRows(first, last, bitboard ? &rowMasks[t] : nullptr);
+        });
+        current.swap(next);
+        ++steps;
+        if (bitboard) {
+            bitboard.swap(nextBitboard);
+        }
+        if (obstacles) {
+            obstacles->update(scenario, current, next);
+        }
+        evaluations += scenario.size();
+    }
+
+    [[nodiscard]] long time() const {
+        return steps;
+    }
+
+    [[nodiscard]] const std::vector<playerState>& states() const {
+        return current;
+    }
+
+    //! Number of cell evaluations since the last reset (obstacle cells skipped by the obstacle field included)
+    [[nodiscard]] long evaluatedCells() const {
+        return evaluations;
+    }
+
+    //! Number of obstacle cells skipped by a step (0 without the obstacle field)
+    [[nodiscard]] int elidedCells() const {
+        return obstacles ? obstacles->elidedCells() : 0;
+    }
+
+    [[nodiscard]] const Scenario& getScenario() const {
+        return scenario;
+    }
+};
+
+#endif // GRID_ENGINE_HPP
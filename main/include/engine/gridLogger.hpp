@@ -0,0 +1,48 @@
+#ifndef GRID_LOGGER_HPP
+#define GRID_LOGGER_HPP
+
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "scenario.hpp"
+
+//! Writes the engine states with the same layout as Cadmium's CSVLogger, so grid_log.csv still opens in the Cell-DEVS viewer
+class GridLogger {
+    std::ofstream file;
+    std::string sep;
+
+    public:
+    GridLogger(const std::string& filePath, const std::string& separator): file(filePath), sep(separator) {
+        if (!file) {
+            throw std::runtime_error("unable to open log file " + filePath);
+        }
+        file << "sep=" << sep << "\n";
+        file << "time" << sep << "model_id" << sep << "model_name" << sep << "port_name" << sep << "data" << "\n";
+    }
+
+    //! Logs the state of one cell (row-major index i)
+    void logCell(long time, const Scenario& scenario, int i, const playerState& state) {
+        int row = scenario.originRow + i / scenario.cols;
+        int col = scenario.originCol + i % scenario.cols;
+        file << time << sep << (i + 1) << sep << "(" << row << "," << col << ")" << sep << sep << state << "\n";
+    }
+
+    //! Logs every cell (initial state)
+    void logGrid(long time, const Scenario& scenario, std::span<const playerState> states) {
+        for (int i = 0; i < scenario.size(); ++i) {
+            logCell(time, scenario, i, states[i]);
+        }
+    }
+
+    //! Logs the cells whose state changed during a step
+    void logChanges(long time, const Scenario& scenario, std::span<const playerState> before, std::span<const playerState> after) {
+        for (int i = 0; i < scenario.size(); ++i) {
+            if (before[i] != after[i]) {
+                logCell(time, scenario, i, after[i]);
+            }
+        }
+    }
+};
+
+#endif // GRID_LOGGER_HPP
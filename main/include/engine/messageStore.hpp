@@ -0,0 +1,251 @@
+#ifndef MESSAGE_STORE_HPP
+#define MESSAGE_STORE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+
+//! Von Neumann neighborhoods of every cell (the cell itself included, as in Cadmium)
+struct NeighborhoodTopology {
+    std::vector<std::vector<int>> neighborhood;                     // cell -> neighbor cells
+    std::vector<std::vector<std::pair<int, int>>> influencees;      // cell -> (influencee, position of the cell in its neighborhood)
+    std::vector<std::array<int, NEIGHBOR_SLOTS>> rulePositions;     // cell -> position of each rule slot in its neighborhood (-1 if absent)
+
+    [[nodiscard]] int size() const {
+        return static_cast<int>(neighborhood.size());
+    }
+};
+
+inline NeighborhoodTopology buildTopology(const Scenario& scenario) {
+    NeighborhoodTopology topology;
+    topology.neighborhood.resize(scenario.size());
+    topology.influencees.resize(scenario.size());
+    topology.rulePositions.resize(scenario.size());
+
+    for (int row = 0; row < scenario.rows; ++row) {
+        for (int col = 0; col < scenario.cols; ++col) {
+            const int cell = scenario.index(row, col);
+            auto& neighborhood = topology.neighborhood[cell];
+
+            for (int dr = -scenario.range; dr <= scenario.range; ++dr) {
+                for (int dc = -scenario.range; dc <= scenario.range; ++dc) {
+                    if (std::abs(dr) + std::abs(dc) > scenario.range) continue;
+                    int r = row + dr;
+                    int c = col + dc;
+                    if (scenario.wrapped) {
+                        r = (r % scenario.rows + scenario.rows) % scenario.rows;
+                        c = (c % scenario.cols + scenario.cols) % scenario.cols;
+                    } else if (r < 0 || r >= scenario.rows || c < 0 || c >= scenario.cols) {
+                        continue;
+                    }
+                    int neighbor = scenario.index(r, c);
+                    if (std::find(neighborhood.begin(), neighborhood.end(), neighbor) == neighborhood.end()) {
+                        neighborhood.push_back(neighbor);
+                    }
+                }
+            }
+
+            for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+                int neighbor = scenario.neighborIndex(row, col, slot);
+                auto it = std::find(neighborhood.begin(), neighborhood.end(), neighbor);
+                topology.rulePositions[cell][slot] = (neighbor < 0) ? -1 : static_cast<int>(it - neighborhood.begin());
+            }
+        }
+    }
+
+    for (int cell = 0; cell < topology.size(); ++cell) {
+        for (int k = 0; k < static_cast<int>(topology.neighborhood[cell].size()); ++k) {
+            topology.influencees[topology.neighborhood[cell][k]].emplace_back(cell, k);
+        }
+    }
+    return topology;
+}
+
+//! Cadmium-like message store: every output allocates a std::shared_ptr<const playerState> snapshot that is copied
+//! into the neighborhood of each influencee (NeighborData), and each cell queues its delayed outputs in a std::multimap
+class SharedMessageStore {
+    const NeighborhoodTopology* topology = nullptr;
+    std::vector<std::multimap<double, playerState>> queues;                     // delayed outputs of every cell
+    std::vector<std::vector<std::shared_ptr<const playerState>>> neighborData;  // cell -> snapshot of every neighbor
+
+    public:
+    void init(const NeighborhoodTopology& t, const std::vector<playerState>& initial) {
+        topology = &t;
+        queues.assign(t.size(), {});
+        neighborData.assign(t.size(), {});
+        for (int cell = 0; cell < t.size(); ++cell) {
+            for (int neighbor: t.neighborhood[cell]) {
+                neighborData[cell].push_back(std::make_shared<const playerState>(initial[neighbor]));
+            }
+        }
+    }
+
+    //! Queues an output (returns true if it became the next output of the cell)
+    bool push(int cell, double time, const playerState& state, bool inertial) {
+        auto& queue = queues[cell];
+        if (inertial) {
+            queue.clear();
+        }
+        bool first = queue.empty() || time < queue.begin()->first;
+        queue.emplace(time, state);
+        return first;
+    }
+
+    [[nodiscard]] std::optional<double> nextTime(int cell) const {
+        return queues[cell].empty() ? std::nullopt : std::optional<double>(queues[cell].begin()->first);
+    }
+
+    //! Sends the next output of a cell to its influencees
+    void deliver(int cell) {
+        auto snapshot = std::make_shared<const playerState>(queues[cell].begin()->second);
+        queues[cell].erase(queues[cell].begin());
+        for (const auto& [influencee, position]: topology->influencees[cell]) {
+            neighborData[influencee][position] = snapshot;
+        }
+    }
+
+    [[nodiscard]] NeighborStates neighbors(int cell) const {
+        NeighborStates states{};
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            int position = topology->rulePositions[cell][slot];
+            states[slot] = (position < 0) ? nullptr : neighborData[cell][position].get();
+        }
+        return states;
+    }
+
+    //! Per-step scratch memory (plain heap allocations)
+    std::pmr::memory_resource* stepResource() {
+        return std::pmr::new_delete_resource();
+    }
+
+    void endStep() {}
+};
+
+//! Pooled message store: the outputs seen by the neighbors live in one preallocated array (one slot per cell, no
+//! snapshot allocation or reference counting), delay-queue entries come from a free-list pool and per-step scratch
+//! memory comes from a monotonic arena that is released wholesale at the end of every time step
+class PooledMessageStore {
+    struct Entry {
+        double time;
+        playerState state;
+        int next;       // next entry of the same cell queue (or of the free list)
+    };
+
+    const NeighborhoodTopology* topology = nullptr;
+    std::vector<playerState> published;     // last output of every cell
+    std::vector<Entry> pool;                // delay-queue entries
+    int freeList = -1;
+    std::vector<int> heads;                 // first (earliest) entry of every cell queue
+    std::vector<int> tails;                 // last entry of every cell queue
+    std::vector<std::byte> stepBuffer;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> stepArena;
+
+    int allocateEntry(double time, const playerState& state) {
+        if (freeList < 0) {
+            pool.push_back({time, state, -1});
+            return static_cast<int>(pool.size()) - 1;
+        }
+        int entry = freeList;
+        freeList = pool[entry].next;
+        pool[entry] = {time, state, -1};
+        return entry;
+    }
+
+    void releaseEntry(int entry) {
+        pool[entry].next = freeList;
+        freeList = entry;
+    }
+
+    public:
+    void init(const NeighborhoodTopology& t, const std::vector<playerState>& initial) {
+        topology = &t;
+        published = initial;
+        pool.clear();
+        pool.reserve(2 * t.size());        // one pending output per cell with a constant delay (plus slack)
+        freeList = -1;
+        heads.assign(t.size(), -1);
+        tails.assign(t.size(), -1);
+        // a step allocates its receivers once, reserved for every cell (one int per cell, plus alignment slack)
+        stepBuffer.resize(t.size() * sizeof(int) + alignof(std::max_align_t));
+        stepArena = std::make_unique<std::pmr::monotonic_buffer_resource>(stepBuffer.data(), stepBuffer.size());
+    }
+
+    //! Queues an output (returns true if it became the next output of the cell)
+    bool push(int cell, double time, const playerState& state, bool inertial) {
+        if (inertial) {
+            for (int entry = heads[cell]; entry >= 0;) {
+                int next = pool[entry].next;
+                releaseEntry(entry);
+                entry = next;
+            }
+            heads[cell] = tails[cell] = -1;
+        }
+
+        int entry = allocateEntry(time, state);
+        if (heads[cell] < 0) {
+            heads[cell] = tails[cell] = entry;
+            return true;
+        }
+        if (pool[tails[cell]].time <= time) {       // constant delays always append
+            pool[tails[cell]].next = entry;
+            tails[cell] = entry;
+            return false;
+        }
+        if (time < pool[heads[cell]].time) {
+            pool[entry].next = heads[cell];
+            heads[cell] = entry;
+            return true;
+        }
+        int previous = heads[cell];
+        while (pool[pool[previous].next].time <= time) {
+            previous = pool[previous].next;
+        }
+        pool[entry].next = pool[previous].next;
+        pool[previous].next = entry;
+        return false;
+    }
+
+    [[nodiscard]] std::optional<double> nextTime(int cell) const {
+        return (heads[cell] < 0) ? std::nullopt : std::optional<double>(pool[heads[cell]].time);
+    }
+
+    //! Sends the next output of a cell to its influencees
+    void deliver(int cell) {
+        int entry = heads[cell];
+        published[cell] = pool[entry].state;
+        heads[cell] = pool[entry].next;
+        if (heads[cell] < 0) {
+            tails[cell] = -1;
+        }
+        releaseEntry(entry);
+    }
+
+    [[nodiscard]] NeighborStates neighbors(int cell) const {
+        NeighborStates states{};
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            int position = topology->rulePositions[cell][slot];
+            states[slot] = (position < 0) ? nullptr : &published[topology->neighborhood[cell][position]];
+        }
+        return states;
+    }
+
+    //! Per-step scratch memory (recycled by endStep)
+    std::pmr::memory_resource* stepResource() {
+        return stepArena.get();
+    }
+
+    void endStep() {
+        stepArena->release();
+    }
+};
+
+#endif // MESSAGE_STORE_HPP
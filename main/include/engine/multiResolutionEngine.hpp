@@ -0,0 +1,455 @@
+#ifndef MULTI_RESOLUTION_ENGINE_HPP
+#define MULTI_RESOLUTION_ENGINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+#include "../data_structures/philox.hpp"
+
+//! Synchronous stepper of the player grid on a quadtree of tiles (same states as GridEngine)
+//! The grid is split in square tiles of tileSize x tileSize cells. A quadtree over the tiles stores large regions of
+//! identical quiet cells as uniform blocks (one state for the whole block) and the rest as dense tiles. Only dense
+//! tiles are evaluated, so a uniform block costs O(1) memory and no work per step. After every step, blocks within
+//! range 2 of a cell that is not quiet are split down to dense tiles (a change spreads one cell per step), and dense
+//! tiles that became uniform and quiet far from any activity are merged back with their siblings.
+class MultiResolutionEngine {
+    public:
+    static constexpr int DEFAULT_TILE_SIZE = 16;
+
+    private:
+    //! Quadtree node: a block of size x size tiles
+    struct Node {
+        int parent;
+        int row;                        // first tile row
+        int col;                        // first tile column
+        int size;                       // tiles per side (power of two)
+        std::array<int, 4> children;    // north-west, north-east, south-west, south-east (-1 on leaves)
+        int tile;                       // dense tile of a leaf (-1 on uniform leaves)
+        playerState uniform;            // state of every cell of a uniform leaf
+    };
+
+    //! Dense tile (double buffered, cells outside the grid are unused)
+    struct Tile {
+        int row;
+        int col;
+        int node;                       // leaf that owns the tile
+        int position;                   // index in Tree::dense
+        bool active;                    // holds a cell that is not quiet
+        std::array<std::vector<playerState>, 2> cells;
+    };
+
+    struct Tree {
+        std::vector<Node> nodes;
+        std::vector<int> freeNodes;
+        std::vector<Tile> tiles;
+        std::vector<int> freeTiles;
+        std::vector<int> dense;         // tiles in use
+    };
+
+    Scenario scenario;                  // shape and neighborhood (the initial grid is kept in initialTree)
+    int tileSize;
+    int tileShift;
+    int tileRows;
+    int tileCols;
+    int rootSize;                       // tiles per side of the root block
+    Tree tree;
+    Tree initialTree;
+    int front;                          // buffer of the dense tiles holding the last computed step
+    long steps;
+    std::optional<std::uint64_t> seed;
+    std::vector<long> neededAt;         // tile -> last refresh that found a cell that is not quiet within range 2
+    long refreshes;
+    std::vector<int> scratchRows;
+    std::vector<int> scratchCols;
+    std::vector<std::pair<int, int>> scratchNeeded;
+
+    [[nodiscard]] bool outside(const Node& node) const {
+        return node.row >= tileRows || node.col >= tileCols;
+    }
+
+    [[nodiscard]] int validRows(const Tile& tile) const {
+        return std::min(tileSize, scenario.rows - (tile.row << tileShift));
+    }
+
+    [[nodiscard]] int validCols(const Tile& tile) const {
+        return std::min(tileSize, scenario.cols - (tile.col << tileShift));
+    }
+
+    int newNode(int parent, int row, int col, int size, const playerState& uniform) {
+        Node node{parent, row, col, size, {-1, -1, -1, -1}, -1, uniform};
+        if (tree.freeNodes.empty()) {
+            tree.nodes.push_back(node);
+            return static_cast<int>(tree.nodes.size()) - 1;
+        }
+        int index = tree.freeNodes.back();
+        tree.freeNodes.pop_back();
+        tree.nodes[index] = node;
+        return index;
+    }
+
+    //! Turns a uniform leaf of one tile into a dense tile filled with its state
+    void makeDense(int nodeIndex) {
+        int index;
+        if (tree.freeTiles.empty()) {
+            tree.tiles.emplace_back();
+            index = static_cast<int>(tree.tiles.size()) - 1;
+        } else {
+            index = tree.freeTiles.back();
+            tree.freeTiles.pop_back();
+        }
+        Node& node = tree.nodes[nodeIndex];
+        Tile& tile = tree.tiles[index];
+        tile.row = node.row;
+        tile.col = node.col;
+        tile.node = nodeIndex;
+        tile.position = static_cast<int>(tree.dense.size());
+        tile.active = false;
+        for (auto& buffer: tile.cells) {
+            buffer.assign(tileSize * tileSize, node.uniform);
+        }
+        node.tile = index;
+        tree.dense.push_back(index);
+    }
+
+    //! Turns a dense tile into a uniform leaf of a state and releases the tile
+    void makeUniform(int tileIndex, const playerState& state) {
+        Tile& tile = tree.tiles[tileIndex];
+        Node& node = tree.nodes[tile.node];
+        node.tile = -1;
+        node.uniform = state;
+
+        int last = tree.dense.back();
+        tree.dense[tile.position] = last;
+        tree.tiles[last].position = tile.position;
+        tree.dense.pop_back();
+        tree.freeTiles.push_back(tileIndex);
+    }
+
+    //! Collapses a node whose children are uniform leaves of the same state (blocks outside the grid match any state)
+    bool tryCollapse(int nodeIndex) {
+        const Node& node = tree.nodes[nodeIndex];
+        const playerState* state = nullptr;
+        for (int child: node.children) {
+            const Node& c = tree.nodes[child];
+            if (c.children[0] >= 0 || c.tile >= 0) {
+                return false;
+            }
+            if (outside(c)) continue;
+            if (state != nullptr && *state != c.uniform) {
+                return false;
+            }
+            state = &c.uniform;
+        }
+        playerState uniform = (state != nullptr) ? *state : tree.nodes[node.children[0]].uniform;
+        for (int child: tree.nodes[nodeIndex].children) {
+            tree.freeNodes.push_back(child);
+        }
+        Node& collapsed = tree.nodes[nodeIndex];
+        collapsed.children = {-1, -1, -1, -1};
+        collapsed.uniform = uniform;
+        return true;
+    }
+
+    //! Builds the block of size x size tiles at (row, col) from a row-major grid
+    int buildNode(int parent, int row, int col, int size, const std::vector<playerState>& grid) {
+        int index = newNode(parent, row, col, size, scenario.defaultState);
+        if (outside(tree.nodes[index])) {
+            return index;
+        }
+        if (size == 1) {
+            const int r0 = row << tileShift;
+            const int c0 = col << tileShift;
+            const int rows = std::min(tileSize, scenario.rows - r0);
+            const int cols = std::min(tileSize, scenario.cols - c0);
+            const playerState& first = grid[scenario.index(r0, c0)];
+            bool uniform = isQuiet(first);
+            for (int r = 0; r < rows && uniform; ++r) {
+                for (int c = 0; c < cols && uniform; ++c) {
+                    uniform = !(grid[scenario.index(r0 + r, c0 + c)] != first);
+                }
+            }
+            tree.nodes[index].uniform = first;
+            if (!uniform) {
+                makeDense(index);
+                Tile& tile = tree.tiles[tree.nodes[index].tile];
+                for (int r = 0; r < rows; ++r) {
+                    for (int c = 0; c < cols; ++c) {
+                        const playerState& state = grid[scenario.index(r0 + r, c0 + c)];
+                        tile.cells[0][r * tileSize + c] = state;
+                        tile.active = tile.active || !isQuiet(state);
+                    }
+                }
+                tile.cells[1] = tile.cells[0];
+            }
+            return index;
+        }
+        const int half = size / 2;
+        std::array<int, 4> children{};
+        for (int q = 0; q < 4; ++q) {
+            children[q] = buildNode(index, row + (q / 2) * half, col + (q % 2) * half, half, grid);
+        }
+        tree.nodes[index].children = children;
+        tryCollapse(index);
+        return index;
+    }
+
+    //! Leaf holding a tile
+    [[nodiscard]] int findLeaf(int tileRow, int tileCol) const {
+        int index = 0;
+        while (tree.nodes[index].children[0] >= 0) {
+            const Node& node = tree.nodes[index];
+            const int half = node.size / 2;
+            const int q = ((tileRow >= node.row + half) ? 2 : 0) + ((tileCol >= node.col + half) ? 1 : 0);
+            index = node.children[q];
+        }
+        return index;
+    }
+
+    //! Splits the uniform blocks covering a tile down to a dense tile
+    void splitToTile(int tileRow, int tileCol) {
+        int index = 0;
+        while (true) {
+            if (tree.nodes[index].children[0] < 0) {
+                if (tree.nodes[index].tile >= 0) {
+                    return;
+                }
+                if (tree.nodes[index].size == 1) {
+                    makeDense(index);
+                    return;
+                }
+                const Node node = tree.nodes[index];
+                const int half = node.size / 2;
+                std::array<int, 4> children{};
+                for (int q = 0; q < 4; ++q) {
+                    children[q] = newNode(index, node.row + (q / 2) * half, node.col + (q % 2) * half, half, node.uniform);
+                }
+                tree.nodes[index].children = children;
+            }
+            const Node& node = tree.nodes[index];
+            const int half = node.size / 2;
+            index = node.children[((tileRow >= node.row + half) ? 2 : 0) + ((tileCol >= node.col + half) ? 1 : 0)];
+        }
+    }
+
+    //! Tile rows (or columns) holding the cells [first, last] of one axis (wrapped or clipped like the neighborhood)
+    void tilesOnAxis(int first, int last, int cells, std::vector<int>& out) const {
+        out.clear();
+        for (int i = first; i <= last; ++i) {
+            int cell = i;
+            if (scenario.wrapped) {
+                cell = (cell % cells + cells) % cells;
+            } else if (cell < 0 || cell >= cells) {
+                continue;
+            }
+            if (out.empty() || out.back() != (cell >> tileShift)) {
+                out.push_back(cell >> tileShift);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    //! Marks every tile with a cell within range 2 of an active tile and splits the ones that are uniform blocks,
+    //! then merges the dense tiles that are quiet, uniform and not marked
+    void refresh() {
+        ++refreshes;
+        scratchNeeded.clear();
+        for (int index: tree.dense) {
+            const Tile& tile = tree.tiles[index];
+            if (!tile.active) continue;
+            const int r0 = tile.row << tileShift;
+            const int c0 = tile.col << tileShift;
+            tilesOnAxis(r0 - 2, r0 + validRows(tile) + 1, scenario.rows, scratchRows);
+            tilesOnAxis(c0 - 2, c0 + validCols(tile) + 1, scenario.cols, scratchCols);
+            for (int tr: scratchRows) {
+                for (int tc: scratchCols) {
+                    long& stamp = neededAt[tr * tileCols + tc];
+                    if (stamp != refreshes) {
+                        stamp = refreshes;
+                        scratchNeeded.emplace_back(tr, tc);
+                    }
+                }
+            }
+        }
+        for (const auto& [tr, tc]: scratchNeeded) {
+            splitToTile(tr, tc);
+        }
+
+        for (std::size_t i = tree.dense.size(); i-- > 0;) {
+            const int index = tree.dense[i];
+            const Tile& tile = tree.tiles[index];
+            if (tile.active || neededAt[tile.row * tileCols + tile.col] == refreshes) continue;
+
+            const auto& cells = tile.cells[front];
+            const playerState first = cells[0];
+            bool uniform = true;
+            for (int r = 0; r < validRows(tile) && uniform; ++r) {
+                for (int c = 0; c < validCols(tile) && uniform; ++c) {
+                    uniform = !(cells[r * tileSize + c] != first);
+                }
+            }
+            if (!uniform) continue;
+
+            int parent = tree.nodes[tile.node].parent;
+            makeUniform(index, first);
+            while (parent >= 0 && tryCollapse(parent)) {
+                parent = tree.nodes[parent].parent;
+            }
+        }
+    }
+
+    //! Computes the next state of every cell of a dense tile
+    void stepTile(Tile& tile) {
+        const auto& current = tile.cells[front];
+        auto& next = tile.cells[front ^ 1];
+        const int r0 = tile.row << tileShift;
+        const int c0 = tile.col << tileShift;
+        const int mask = tileSize - 1;
+        bool active = false;
+
+        for (int lr = 0; lr < validRows(tile); ++lr) {
+            for (int lc = 0; lc < validCols(tile); ++lc) {
+                const int row = r0 + lr;
+                const int col = c0 + lc;
+                NeighborStates neighbors{};
+                for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+                    const int n = scenario.neighborIndex(row, col, slot);
+                    if (n < 0) continue;
+                    const int nr = n / scenario.cols;
+                    const int nc = n % scenario.cols;
+                    if ((nr >> tileShift) == tile.row && (nc >> tileShift) == tile.col) {
+                        neighbors[slot] = &current[(nr & mask) * tileSize + (nc & mask)];
+                    } else {
+                        neighbors[slot] = &cell(nr, nc);
+                    }
+                }
+
+                const int cellRow = scenario.originRow + row;
+                playerState& result = next[lr * tileSize + lc];
+                if (seed) {
+                    DecisionSampler sampler(*seed, cellRow, scenario.originCol + col, steps);
+                    result = playerTransition(current[lr * tileSize + lc], neighbors, cellRow, &sampler);
+                } else {
+                    result = playerTransition(current[lr * tileSize + lc], neighbors, cellRow);
+                }
+                active = active || !isQuiet(result);
+            }
+        }
+        tile.active = active;
+    }
+
+    [[nodiscard]] static std::size_t treeBytes(const Tree& t) {
+        std::size_t bytes = t.nodes.capacity() * sizeof(Node) + t.tiles.capacity() * sizeof(Tile) +
+                            (t.freeNodes.capacity() + t.freeTiles.capacity() + t.dense.capacity()) * sizeof(int);
+        for (const auto& tile: t.tiles) {
+            bytes += (tile.cells[0].capacity() + tile.cells[1].capacity()) * sizeof(playerState);
+        }
+        return bytes;
+    }
+
+    public:
+    explicit MultiResolutionEngine(const Scenario& s, int tileSideCells = DEFAULT_TILE_SIZE): tileSize(tileSideCells), tileShift(0), front(0), steps(0), refreshes(0) {
+        if (tileSize < 2 || (tileSize & (tileSize - 1)) != 0) {
+            throw std::invalid_argument("tile size must be a power of two (at least 2)");
+        }
+        while ((1 << tileShift) < tileSize) {
+            ++tileShift;
+        }
+        scenario.path = s.path;
+        scenario.rows = s.rows;
+        scenario.cols = s.cols;
+        scenario.originRow = s.originRow;
+        scenario.originCol = s.originCol;
+        scenario.wrapped = s.wrapped;
+        scenario.range = s.range;
+        scenario.delay = s.delay;
+        scenario.defaultState = s.defaultState;
+
+        tileRows = (scenario.rows + tileSize - 1) / tileSize;
+        tileCols = (scenario.cols + tileSize - 1) / tileSize;
+        rootSize = 1;
+        while (rootSize < std::max(tileRows, tileCols)) {
+            rootSize *= 2;
+        }
+        neededAt.assign(static_cast<std::size_t>(tileRows) * tileCols, 0);
+
+        buildNode(-1, 0, 0, rootSize, s.initial);
+        refresh();
+        initialTree = tree;
+    }
+
+    //! Enables the stochastic decision mode
+    void setSeed(std::uint64_t s) {
+        seed = s;
+    }
+
+    //! Restores the initial state of the scenario
+    void reset() {
+        tree = initialTree;
+        front = 0;
+        steps = 0;
+    }
+
+    //! Computes the next time step
+    void step() {
+        for (int index: tree.dense) {
+            stepTile(tree.tiles[index]);
+        }
+        front ^= 1;
+        ++steps;
+        refresh();
+    }
+
+    [[nodiscard]] long time() const {
+        return steps;
+    }
+
+    //! State of a cell after the last step
+    [[nodiscard]] const playerState& cell(int row, int col) const {
+        const Node& leaf = tree.nodes[findLeaf(row >> tileShift, col >> tileShift)];
+        if (leaf.tile < 0) {
+            return leaf.uniform;
+        }
+        const int mask = tileSize - 1;
+        return tree.tiles[leaf.tile].cells[front][(row & mask) * tileSize + (col & mask)];
+    }
+
+    //! Row-major copy of the grid
+    [[nodiscard]] std::vector<playerState> states() const {
+        std::vector<playerState> grid(scenario.size());
+        for (int row = 0; row < scenario.rows; ++row) {
+            for (int col = 0; col < scenario.cols; ++col) {
+                grid[scenario.index(row, col)] = cell(row, col);
+            }
+        }
+        return grid;
+    }
+
+    [[nodiscard]] const Scenario& getScenario() const {
+        return scenario;
+    }
+
+    //! Number of dense tiles (the only ones evaluated by a step)
+    [[nodiscard]] int denseTiles() const {
+        return static_cast<int>(tree.dense.size());
+    }
+
+    //! Number of quadtree nodes in use
+    [[nodiscard]] int nodeCount() const {
+        return static_cast<int>(tree.nodes.size() - tree.freeNodes.size());
+    }
+
+    //! Bytes held by the engine (current and initial trees included)
+    [[nodiscard]] std::size_t memoryBytes() const {
+        return treeBytes(tree) + treeBytes(initialTree) + neededAt.capacity() * sizeof(long) + sizeof(*this);
+    }
+};
+
+#endif // MULTI_RESOLUTION_ENGINE_HPP
@@ -0,0 +1,191 @@
+#ifndef OBSTACLE_FIELD_HPP
+#define OBSTACLE_FIELD_HPP
+
+#include <cstdint>
+#include <vector>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+
+//! Obstacle bits of a cell in ObstacleField
+enum ObstacleBit : std::uint8_t {
+    INTERCEPTION_NORTH_BIT = 1 << 0,    // north neighbor is an obstacle (no player or ball on it)
+    INTERCEPTION_SOUTH_BIT = 1 << 1,
+    NEAR_NORTH_BIT = 1 << 2,            // north neighbor is near an obstacle
+    NEAR_SOUTH_BIT = 1 << 3,
+    NEAR_EAST_BIT = 1 << 4,
+    NEAR_WEST_BIT = 1 << 5,
+    ADJACENT_BIT = 1 << 6,              // a direct neighbor has an obstacle (the cell becomes near_obstacle)
+    ELIDED_BIT = 1 << 7                 // obstacle cell at its fixed point (not evaluated)
+};
+
+//! Obstacle flags of every cell, computed once from the grid and only updated where an obstacle attribute can change
+//! has_obstacle never changes and near_obstacle is only ever raised (by a direct neighbor with an obstacle), so after
+//! the first step the flags are static. The only cells watched after that are obstacles holding a player or a ball
+//! (they stop being obstacles for the interception flags when the player leaves) and the cells set by hand.
+//! An obstacle cell without a player or ball is never entered or passed to, so once its own transition leaves it
+//! unchanged (and both step buffers hold that state) it is elided from the evaluated set.
+class ObstacleField {
+    std::vector<std::uint8_t> bits;
+    std::vector<int> watched;           // cells whose obstacle attributes can change during the next step
+    std::vector<int> candidates;        // obstacle cells not elided yet
+    int elided;
+
+    //! Obstacle attributes of a cell may still change (near_obstacle raised, player or ball leaving an obstacle)
+    [[nodiscard]] static bool settling(const playerState& s, std::uint8_t b) {
+        return (s.has_obstacle && (s.has_player || s.has_ball)) || (!s.near_obstacle && (b & ADJACENT_BIT));
+    }
+
+    //! Recomputes the obstacle bits of a cell from its direct neighbors
+    void computeBits(const Scenario& scenario, const std::vector<playerState>& grid, int row, int col) {
+        const int i = scenario.index(row, col);
+        std::uint8_t b = bits[i] & ELIDED_BIT;
+        auto set = [&b](bool value, std::uint8_t bit) {
+            b |= value ? bit : 0;
+        };
+        const NeighborStates neighbors = scenario.gatherNeighbors(grid, row, col);
+        if (const playerState* n = neighbors[NORTH_SLOT]) {
+            set(isObstacle(*n), INTERCEPTION_NORTH_BIT);
+            set(n->near_obstacle, NEAR_NORTH_BIT);
+        }
+        if (const playerState* n = neighbors[SOUTH_SLOT]) {
+            set(isObstacle(*n), INTERCEPTION_SOUTH_BIT);
+            set(n->near_obstacle, NEAR_SOUTH_BIT);
+        }
+        if (const playerState* n = neighbors[EAST_SLOT]) {
+            set(n->near_obstacle, NEAR_EAST_BIT);
+        }
+        if (const playerState* n = neighbors[WEST_SLOT]) {
+            set(n->near_obstacle, NEAR_WEST_BIT);
+        }
+        for (int slot: {NORTH_SLOT, WEST_SLOT, EAST_SLOT, SOUTH_SLOT}) {
+            set(neighbors[slot] != nullptr && neighbors[slot]->has_obstacle, ADJACENT_BIT);
+        }
+        bits[i] = b;
+    }
+
+    //! Cell i and its direct neighbors (the cells whose bits read cell i)
+    template <typename Function>
+    void forAround(const Scenario& scenario, int i, Function function) {
+        const int row = i / scenario.cols;
+        const int col = i % scenario.cols;
+        function(i);
+        for (int slot: {NORTH_SLOT, WEST_SLOT, EAST_SLOT, SOUTH_SLOT}) {
+            const int n = scenario.neighborIndex(row, col, slot);
+            if (n >= 0) {
+                function(n);
+            }
+        }
+    }
+
+    //! Recomputes the bits of the cells that read cell i
+    void refreshAround(const Scenario& scenario, const std::vector<playerState>& grid, int i) {
+        forAround(scenario, i, [&](int n) {
+            if (n != i) {
+                computeBits(scenario, grid, n / scenario.cols, n % scenario.cols);
+            }
+        });
+    }
+
+    public:
+    ObstacleField(): elided(0) {}
+
+    //! Computes the field of a grid (no cell is elided before the first step)
+    void build(const Scenario& scenario, const std::vector<playerState>& grid) {
+        bits.assign(scenario.size(), 0);
+        watched.clear();
+        candidates.clear();
+        elided = 0;
+        for (int row = 0; row < scenario.rows; ++row) {
+            for (int col = 0; col < scenario.cols; ++col) {
+                computeBits(scenario, grid, row, col);
+            }
+        }
+        for (int i = 0; i < scenario.size(); ++i) {
+            if (settling(grid[i], bits[i])) {
+                watched.push_back(i);
+            }
+            if (isObstacle(grid[i])) {
+                candidates.push_back(i);
+            }
+        }
+    }
+
+    //! Updates the field after a step (current: states after the step, previous: states before it)
+    void update(const Scenario& scenario, const std::vector<playerState>& current, const std::vector<playerState>& previous) {
+        std::erase_if(watched, [&](int i) {
+            refreshAround(scenario, current, i);
+            return !settling(current[i], bits[i]);
+        });
+        std::erase_if(candidates, [&](int i) {
+            if (bits[i] & ELIDED_BIT) {
+                return true;
+            }
+            if (!isObstacle(current[i])) {
+                return true;
+            }
+            if (current[i] != previous[i]) {
+                return false;
+            }
+            const int row = i / scenario.cols;
+            const int col = i % scenario.cols;
+            const playerState next = playerTransition(current[i], scenario.gatherNeighbors(current, row, col), scenario.originRow + row);
+            if (next != current[i]) {
+                return false;
+            }
+            bits[i] |= ELIDED_BIT;
+            ++elided;
+            return true;
+        });
+    }
+
+    //! Updates the field after the state of cell i was replaced by hand
+    void cellChanged(const Scenario& scenario, const std::vector<playerState>& grid, int i) {
+        refreshAround(scenario, grid, i);
+        forAround(scenario, i, [&](int n) {
+            // a neighbor may have gained or lost an adjacent obstacle, so none of them is a fixed point anymore
+            if (bits[n] & ELIDED_BIT) {
+                bits[n] &= ~ELIDED_BIT;
+                --elided;
+            }
+            if (settling(grid[n], bits[n])) {
+                watched.push_back(n);
+            }
+            if (isObstacle(grid[n])) {
+                candidates.push_back(n);
+            }
+        });
+    }
+
+    [[nodiscard]] std::uint8_t operator[](int i) const {
+        return bits[i];
+    }
+
+    [[nodiscard]] bool isElided(int i) const {
+        return (bits[i] & ELIDED_BIT) != 0;
+    }
+
+    //! Number of elided obstacle cells
+    [[nodiscard]] int elidedCells() const {
+        return elided;
+    }
+
+    //! Sets the obstacle flags of a cell with a player (same result as collectObstacleFlags)
+    static void applyTo(std::uint8_t b, playerState& state, NeighborFlags& flags) {
+        flags.obstacle_interception_north = (b & INTERCEPTION_NORTH_BIT) != 0;
+        flags.obstacle_interception_south = (b & INTERCEPTION_SOUTH_BIT) != 0;
+        flags.near_north_obstacle = (b & NEAR_NORTH_BIT) != 0;
+        flags.near_south_obstacle = (b & NEAR_SOUTH_BIT) != 0;
+        flags.near_east_obstacle = (b & NEAR_EAST_BIT) != 0;
+        flags.near_west_obstacle = (b & NEAR_WEST_BIT) != 0;
+        raiseNearObstacle(b, state);
+    }
+
+    //! Only raises state.near_obstacle (cells without a player never read the obstacle flags of their neighbors)
+    static void raiseNearObstacle(std::uint8_t b, playerState& state) {
+        if (b & ADJACENT_BIT) {
+            state.near_obstacle = true;
+        }
+    }
+};
+
+#endif // OBSTACLE_FIELD_HPP
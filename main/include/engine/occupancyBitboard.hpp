@@ -0,0 +1,259 @@
+#ifndef OCCUPANCY_BITBOARD_HPP
+#define OCCUPANCY_BITBOARD_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "scenario.hpp"
+#include "../playerRules.hpp"
+
+//! Row masks computed by OccupancyBitboard::computeRowMasks (bit c of a mask refers to the cell in column c)
+enum RowMask {
+    NORTH_EMPTY_MASK,
+    SOUTH_EMPTY_MASK,
+    EAST_EMPTY_MASK,
+    WEST_EMPTY_MASK,
+    NORTH_TEAMMATE_MASK,
+    SOUTH_TEAMMATE_MASK,
+    EAST_TEAMMATE_MASK,
+    WEST_TEAMMATE_MASK,
+    NORTH_EXTENDED_TEAMMATE_MASK,
+    SOUTH_EXTENDED_TEAMMATE_MASK,
+    OBSTACLE_INTERCEPTION_NORTH_MASK,   // north neighbor is an obstacle (no player or ball on it)
+    OBSTACLE_INTERCEPTION_SOUTH_MASK,
+    NEAR_NORTH_OBSTACLE_MASK,           // north neighbor is near an obstacle
+    NEAR_SOUTH_OBSTACLE_MASK,
+    NEAR_EAST_OBSTACLE_MASK,
+    NEAR_WEST_OBSTACLE_MASK,
+    OBSTACLE_ADJACENT_MASK,             // a direct neighbor has an obstacle (the cell becomes near_obstacle)
+    ROW_MASKS
+};
+
+//! Occupancy flags of a whole grid row, ROW_MASKS masks of packed 64-bit words
+class RowMasks {
+    int words;
+    std::vector<std::uint64_t> masks;
+
+    public:
+    explicit RowMasks(int wordsPerRow = 0): words(wordsPerRow), masks(ROW_MASKS * wordsPerRow, 0) {}
+
+    [[nodiscard]] std::uint64_t* mask(int m) {
+        return masks.data() + m * words;
+    }
+
+    [[nodiscard]] const std::uint64_t* mask(int m) const {
+        return masks.data() + m * words;
+    }
+
+    [[nodiscard]] bool test(int m, int col) const {
+        return (mask(m)[col >> 6] >> (col & 63)) & 1;
+    }
+
+    //! Word w of every mask (the masks of 64 consecutive cells)
+    using Word = std::array<std::uint64_t, ROW_MASKS>;
+
+    [[nodiscard]] Word word(int w) const {
+        Word bits;
+        for (int m = 0; m < ROW_MASKS; ++m) {
+            bits[m] = mask(m)[w];
+        }
+        return bits;
+    }
+
+    //! Sets the occupancy flags of the cell at bit b of a mask word (same result as collectOccupancyFlags)
+    static void applyTo(const Word& bits, int b, playerState& state, NeighborFlags& flags) {
+        auto test = [&bits, b](int m) { return ((bits[m] >> b) & 1) != 0; };
+        flags.north_empty = test(NORTH_EMPTY_MASK);
+        flags.south_empty = test(SOUTH_EMPTY_MASK);
+        flags.east_empty = test(EAST_EMPTY_MASK);
+        flags.west_empty = test(WEST_EMPTY_MASK);
+        flags.north_teammate = test(NORTH_TEAMMATE_MASK);
+        flags.south_teammate = test(SOUTH_TEAMMATE_MASK);
+        flags.east_teammate = test(EAST_TEAMMATE_MASK);
+        flags.west_teammate = test(WEST_TEAMMATE_MASK);
+        flags.north_extended_teammate = test(NORTH_EXTENDED_TEAMMATE_MASK);
+        flags.south_extended_teammate = test(SOUTH_EXTENDED_TEAMMATE_MASK);
+        flags.obstacle_interception_north = test(OBSTACLE_INTERCEPTION_NORTH_MASK);
+        flags.obstacle_interception_south = test(OBSTACLE_INTERCEPTION_SOUTH_MASK);
+        flags.near_north_obstacle = test(NEAR_NORTH_OBSTACLE_MASK);
+        flags.near_south_obstacle = test(NEAR_SOUTH_OBSTACLE_MASK);
+        flags.near_east_obstacle = test(NEAR_EAST_OBSTACLE_MASK);
+        flags.near_west_obstacle = test(NEAR_WEST_OBSTACLE_MASK);
+        raiseNearObstacle(bits, b, state);
+    }
+
+    //! Only raises state.near_obstacle (cells without a player never read the occupancy flags of their neighbors)
+    static void raiseNearObstacle(const Word& bits, int b, playerState& state) {
+        if ((bits[OBSTACLE_ADJACENT_MASK] >> b) & 1) {
+            state.near_obstacle = true;
+        }
+    }
+
+    //! Sets the occupancy flags of the cell in column col
+    void applyTo(int col, playerState& state, NeighborFlags& flags) const {
+        applyTo(word(col >> 6), col & 63, state, flags);
+    }
+};
+
+//! Bitboard planes of the grid occupancy (player, ball, obstacle and near_obstacle), one bit per cell packed in
+//! 64-bit words per row. The occupancy flags of the player rules only depend on these four booleans, so the flags
+//! of a whole row are computed with a few word-wide shifts and ANDs (64 cells at a time) instead of reading the
+//! neighbor states one by one. Padding bits past the last column are always 0.
+class OccupancyBitboard {
+    //! Derived occupancy of a row word
+    enum Occupancy { EMPTY, TEAMMATE, OBSTACLE_ONLY, OBSTACLE, NEAR_OBSTACLE };
+
+    int rows;
+    int cols;
+    int words;                          // words per row
+    bool wrapped;
+    int range;
+    std::uint64_t lastWordMask;         // valid bits of the last word of a row
+    std::vector<std::uint64_t> player;
+    std::vector<std::uint64_t> ball;
+    std::vector<std::uint64_t> obstacle;
+    std::vector<std::uint64_t> nearObstacle;
+
+    static void assignBit(std::vector<std::uint64_t>& plane, int word, int bit, bool value) {
+        const std::uint64_t b = std::uint64_t{1} << bit;
+        plane[word] = value ? (plane[word] | b) : (plane[word] & ~b);
+    }
+
+    [[nodiscard]] std::uint64_t validBits(int w) const {
+        return (w == words - 1) ? lastWordMask : ~std::uint64_t{0};
+    }
+
+    //! Row of a vertical neighbor (-1 if it is outside the grid)
+    [[nodiscard]] int neighborRow(int row) const {
+        if (wrapped) {
+            return (row % rows + rows) % rows;
+        }
+        return (row < 0 || row >= rows) ? -1 : row;
+    }
+
+    [[nodiscard]] std::uint64_t occupancy(Occupancy kind, int row, int w) const {
+        const int i = row * words + w;
+        switch (kind) {
+            case EMPTY:         return ~(player[i] | ball[i] | obstacle[i]) & validBits(w);
+            case TEAMMATE:      return player[i] & ~ball[i];
+            case OBSTACLE_ONLY: return obstacle[i] & ~player[i] & ~ball[i];
+            case OBSTACLE:      return obstacle[i];
+            default:            return nearObstacle[i];
+        }
+    }
+
+    //! Occupancy of the cells of another row (0 if the row is outside the grid)
+    [[nodiscard]] std::uint64_t vertical(Occupancy kind, int row, int w) const {
+        return (row < 0) ? 0 : occupancy(kind, row, w);
+    }
+
+    //! Occupancy of the east neighbors of a row word: bit c takes bit c+1 of the row
+    [[nodiscard]] std::uint64_t east(Occupancy kind, int row, int w) const {
+        std::uint64_t bits = occupancy(kind, row, w) >> 1;
+        if (w + 1 < words) {
+            bits |= occupancy(kind, row, w + 1) << 63;
+        }
+        if (wrapped && w == (cols - 1) >> 6) {
+            bits |= (occupancy(kind, row, 0) & 1) << ((cols - 1) & 63);
+        }
+        return bits;
+    }
+
+    //! Occupancy of the west neighbors of a row word: bit c takes bit c-1 of the row
+    [[nodiscard]] std::uint64_t west(Occupancy kind, int row, int w) const {
+        std::uint64_t bits = occupancy(kind, row, w) << 1;
+        if (w > 0) {
+            bits |= occupancy(kind, row, w - 1) >> 63;
+        }
+        bits &= validBits(w);
+        if (wrapped && w == 0) {
+            bits |= (occupancy(kind, row, (cols - 1) >> 6) >> ((cols - 1) & 63)) & 1;
+        }
+        return bits;
+    }
+
+    public:
+    OccupancyBitboard(): rows(0), cols(0), words(0), wrapped(false), range(1), lastWordMask(0) {}
+
+    explicit OccupancyBitboard(const Scenario& scenario):
+        rows(scenario.rows),
+        cols(scenario.cols),
+        words((scenario.cols + 63) / 64),
+        wrapped(scenario.wrapped),
+        range(scenario.range),
+        lastWordMask((scenario.cols % 64 == 0) ? ~std::uint64_t{0} : (std::uint64_t{1} << (scenario.cols % 64)) - 1),
+        player(rows * words, 0),
+        ball(rows * words, 0),
+        obstacle(rows * words, 0),
+        nearObstacle(rows * words, 0) {
+        build(scenario.initial);
+    }
+
+    [[nodiscard]] int wordsPerRow() const {
+        return words;
+    }
+
+    //! Sets every plane from a row-major grid
+    void build(std::span<const playerState> grid) {
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                update(row, col, grid[row * cols + col]);
+            }
+        }
+    }
+
+    //! Updates the bits of one cell
+    void update(int row, int col, const playerState& state) {
+        const int word = row * words + (col >> 6);
+        const int bit = col & 63;
+        assignBit(player, word, bit, state.has_player);
+        assignBit(ball, word, bit, state.has_ball);
+        assignBit(obstacle, word, bit, state.has_obstacle);
+        assignBit(nearObstacle, word, bit, state.near_obstacle);
+    }
+
+    //! Stores the planes of 64 cells of a row (bit c of the words is column 64 * w + c)
+    void storeWord(int row, int w, std::uint64_t playerBits, std::uint64_t ballBits, std::uint64_t obstacleBits, std::uint64_t nearBits) {
+        const int i = row * words + w;
+        player[i] = playerBits;
+        ball[i] = ballBits;
+        obstacle[i] = obstacleBits;
+        nearObstacle[i] = nearBits;
+    }
+
+    //! Computes every occupancy mask of a row (masks must have wordsPerRow() words)
+    void computeRowMasks(int row, RowMasks& masks) const {
+        const int north = neighborRow(row - 1);
+        const int south = neighborRow(row + 1);
+        const int northExtended = (range >= 2) ? neighborRow(row - 2) : -1;
+        const int southExtended = (range >= 2) ? neighborRow(row + 2) : -1;
+
+        for (int w = 0; w < words; ++w) {
+            masks.mask(NORTH_EMPTY_MASK)[w] = vertical(EMPTY, north, w);
+            masks.mask(SOUTH_EMPTY_MASK)[w] = vertical(EMPTY, south, w);
+            masks.mask(EAST_EMPTY_MASK)[w] = east(EMPTY, row, w);
+            masks.mask(WEST_EMPTY_MASK)[w] = west(EMPTY, row, w);
+
+            masks.mask(NORTH_TEAMMATE_MASK)[w] = vertical(TEAMMATE, north, w);
+            masks.mask(SOUTH_TEAMMATE_MASK)[w] = vertical(TEAMMATE, south, w);
+            masks.mask(EAST_TEAMMATE_MASK)[w] = east(TEAMMATE, row, w);
+            masks.mask(WEST_TEAMMATE_MASK)[w] = west(TEAMMATE, row, w);
+            masks.mask(NORTH_EXTENDED_TEAMMATE_MASK)[w] = vertical(TEAMMATE, northExtended, w);
+            masks.mask(SOUTH_EXTENDED_TEAMMATE_MASK)[w] = vertical(TEAMMATE, southExtended, w);
+
+            masks.mask(OBSTACLE_INTERCEPTION_NORTH_MASK)[w] = vertical(OBSTACLE_ONLY, north, w);
+            masks.mask(OBSTACLE_INTERCEPTION_SOUTH_MASK)[w] = vertical(OBSTACLE_ONLY, south, w);
+
+            masks.mask(NEAR_NORTH_OBSTACLE_MASK)[w] = vertical(NEAR_OBSTACLE, north, w);
+            masks.mask(NEAR_SOUTH_OBSTACLE_MASK)[w] = vertical(NEAR_OBSTACLE, south, w);
+            masks.mask(NEAR_EAST_OBSTACLE_MASK)[w] = east(NEAR_OBSTACLE, row, w);
+            masks.mask(NEAR_WEST_OBSTACLE_MASK)[w] = west(NEAR_OBSTACLE, row, w);
+
+            masks.mask(OBSTACLE_ADJACENT_MASK)[w] = vertical(OBSTACLE, north, w) | vertical(OBSTACLE, south, w) |
+                                                    east(OBSTACLE, row, w) | west(OBSTACLE, row, w);
+        }
+    }
+};
+
+#endif // OCCUPANCY_BITBOARD_HPP
@@ -0,0 +1,133 @@
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../playerState.hpp"
+#include "../playerRules.hpp"
+
+//! Grid scenario parsed from a Cell-DEVS JSON configuration (same format as the Cadmium grid model)
+struct Scenario {
+    std::string path;                   // configuration file the scenario was loaded from
+    int rows;                           // scenario.shape[0]
+    int cols;                           // scenario.shape[1]
+    int originRow;                      // scenario.origin[0]
+    int originCol;                      // scenario.origin[1]
+    bool wrapped;                       // scenario.wrapped (toroidal grid)
+    int range;                          // von Neumann range of the neighborhood (extended neighbors need range 2)
+    std::string delay;                  // output delay type of the cells ("transport" or "inertial")
+    playerState defaultState;           // state of the "default" cell configuration
+    std::vector<playerState> initial;   // initial cell states (row-major)
+
+    Scenario(): rows(0), cols(0), originRow(0), originCol(0), wrapped(false), range(1), delay("transport") {}
+
+    [[nodiscard]] int size() const {
+        return rows * cols;
+    }
+
+    [[nodiscard]] int index(int row, int col) const {
+        return row * cols + col;
+    }
+
+    //! Index of the neighbor of (row, col) in a slot (-1 if it is outside the grid or the neighborhood)
+    [[nodiscard]] int neighborIndex(int row, int col, int slot) const {
+        const auto neighbor = neighborCoordinates(row, col, slot, rows, cols, wrapped, range);
+        return neighbor ? index((*neighbor)[0], (*neighbor)[1]) : -1;
+    }
+
+    //! Gathers the neighbor states read by the player rules from a row-major grid
+    [[nodiscard]] NeighborStates gatherNeighbors(const std::vector<playerState>& grid, int row, int col) const {
+        NeighborStates neighbors{};
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            int n = neighborIndex(row, col, slot);
+            neighbors[slot] = (n < 0) ? nullptr : &grid[n];
+        }
+        return neighbors;
+    }
+};
+
+//! It parses the von Neumann range of a cell configuration ("neighborhood": [{"type": "von_neumann", "range": r}])
+inline int parseNeighborhoodRange(const nlohmann::json& cellConfig) {
+    int range = 0;
+    for (const auto& neighborhood: cellConfig.at("neighborhood")) {
+        if (neighborhood.at("type").get<std::string>() != "von_neumann") {
+            throw std::invalid_argument("unsupported neighborhood type: " + neighborhood.at("type").get<std::string>());
+        }
+        range = std::max(range, neighborhood.value("range", 1));
+    }
+    return range;
+}
+
+//! It parses a JSON scenario and generates the corresponding Scenario object
+inline Scenario parseScenario(const nlohmann::json& config) {
+    Scenario scenario;
+
+    const auto& shape = config.at("scenario").at("shape");
+    scenario.rows = shape.at(0).get<int>();
+    scenario.cols = shape.at(1).get<int>();
+    if (config.at("scenario").contains("origin")) {
+        scenario.originRow = config.at("scenario").at("origin").at(0).get<int>();
+        scenario.originCol = config.at("scenario").at("origin").at(1).get<int>();
+    }
+    scenario.wrapped = config.at("scenario").value("wrapped", false);
+    if (scenario.rows <= 0 || scenario.cols <= 0) {
+        throw std::invalid_argument("scenario shape must be positive");
+    }
+
+    const auto& defaultConfig = config.at("cells").at("default");
+    if (defaultConfig.at("model").get<std::string>() != "player") {
+        throw std::bad_typeid();
+    }
+    scenario.range = parseNeighborhoodRange(defaultConfig);
+    scenario.delay = defaultConfig.value("delay", "transport");
+    if (scenario.delay != "transport" && scenario.delay != "inertial") {
+        throw std::invalid_argument("unsupported delay type: " + scenario.delay);
+    }
+    scenario.defaultState = defaultConfig.at("state").get<playerState>();
+    scenario.initial.assign(scenario.size(), scenario.defaultState);
+
+    for (const auto& [cellName, cellConfig]: config.at("cells").items()) {
+        if (cellName == "default") continue;
+
+        // every other cell configuration patches the default one (same as Cadmium)
+        nlohmann::json patched = defaultConfig;
+        patched.merge_patch(cellConfig);
+        if (patched.at("model").get<std::string>() != "player") {
+            throw std::bad_typeid();
+        }
+        if (parseNeighborhoodRange(patched) != scenario.range) {
+            throw std::invalid_argument("cell " + cellName + " overrides the neighborhood range");
+        }
+        auto state = patched.at("state").get<playerState>();
+
+        for (const auto& cell: cellConfig.at("cell_map")) {
+            int row = cell.at(0).get<int>() - scenario.originRow;
+            int col = cell.at(1).get<int>() - scenario.originCol;
+            if (row < 0 || row >= scenario.rows || col < 0 || col >= scenario.cols) {
+                throw std::out_of_range("cell " + cellName + " is outside the scenario shape");
+            }
+            scenario.initial[scenario.index(row, col)] = state;
+        }
+    }
+    return scenario;
+}
+
+//! It loads a JSON scenario file
+inline Scenario loadScenario(const std::string& configFilePath) {
+    std::ifstream file(configFilePath);
+    if (!file) {
+        throw std::runtime_error("unable to open scenario file " + configFilePath);
+    }
+    nlohmann::json config;
+    file >> config;
+
+    Scenario scenario = parseScenario(config);
+    scenario.path = configFilePath;
+    return scenario;
+}
+
+#endif // SCENARIO_HPP
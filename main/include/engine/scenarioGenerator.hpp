@@ -0,0 +1,50 @@
+#ifndef SCENARIO_GENERATOR_HPP
+#define SCENARIO_GENERATOR_HPP
+
+#include <cstdint>
+#include <random>
+#include "scenario.hpp"
+
+//! Parameters of a generated (benchmark) scenario
+struct GeneratorParameters {
+    int rows = 100;
+    int cols = 100;
+    double playerDensity = 0.05;        // probability of a cell holding a player
+    double ballDensity = 0.2;           // probability of a player holding a ball
+    double obstacleDensity = 0.01;      // probability of an empty cell holding an obstacle
+    std::uint64_t seed = 1;
+};
+
+//! Generates a random scenario with range 2 neighborhoods (zones follow the thirds of the pitch)
+inline Scenario generateScenario(const GeneratorParameters& params) {
+    Scenario scenario;
+    scenario.path = "generated";
+    scenario.rows = params.rows;
+    scenario.cols = params.cols;
+    scenario.range = 2;
+    scenario.initial.assign(scenario.size(), scenario.defaultState);
+
+    std::mt19937_64 generator(params.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> role(0, 6);
+
+    for (int row = 0; row < scenario.rows; ++row) {
+        for (int col = 0; col < scenario.cols; ++col) {
+            playerState& s = scenario.initial[scenario.index(row, col)];
+            if (unit(generator) < params.playerDensity) {
+                s.has_player = true;
+                s.has_ball = unit(generator) < params.ballDensity;
+                s.mental = 100.0 * unit(generator);
+                s.fatigue = 60.0 * unit(generator);
+                s.zone_type = (row * 3 < scenario.rows) ? ZoneType::ATTACK : (row * 3 < 2 * scenario.rows) ? ZoneType::MIDFIELD : ZoneType::DEFENSE;
+                s.player_role = static_cast<PlayerRole>(role(generator));
+                s.initial_row = row;
+            } else if (unit(generator) < params.obstacleDensity) {
+                s.has_obstacle = true;
+            }
+        }
+    }
+    return scenario;
+}
+
+#endif // SCENARIO_GENERATOR_HPP
@@ -0,0 +1,63 @@
+#ifndef STATE_HASH_HPP
+#define STATE_HASH_HPP
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include "../playerState.hpp"
+
+//! SplitMix64 finalizer
+constexpr std::uint64_t mixHash(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+constexpr std::uint64_t combineHash(std::uint64_t seed, std::uint64_t value) {
+    return mixHash(seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)));
+}
+
+//! 64-bit hash of every state variable (states that compare equal with operator!= hash equal)
+inline std::uint64_t hashState(const playerState& s) {
+    // +0.0 and -0.0 compare equal, so they must hash equal
+    auto bits = [](double value) { return std::bit_cast<std::uint64_t>(value == 0.0 ? 0.0 : value); };
+
+    std::uint64_t packed = (s.has_player ? 1ULL : 0ULL)
+        | (s.has_ball ? 2ULL : 0ULL)
+        | (s.has_obstacle ? 4ULL : 0ULL)
+        | (s.near_obstacle ? 8ULL : 0ULL)
+        | (static_cast<std::uint64_t>(s.action) << 8)
+        | (static_cast<std::uint64_t>(s.direction) << 16)
+        | (static_cast<std::uint64_t>(s.zone_type) << 24)
+        | (static_cast<std::uint64_t>(s.player_role) << 32);
+
+    std::uint64_t h = mixHash(packed);
+    h = combineHash(h, bits(s.mental));
+    h = combineHash(h, bits(s.fatigue));
+    h = combineHash(h, static_cast<std::uint32_t>(s.initial_row));
+    h = combineHash(h, static_cast<std::uint32_t>(s.inactive_time));
+    return h;
+}
+
+//! 64-bit hash of a frame given the hash of each cell (row-major order matters)
+inline std::uint64_t hashCells(std::span<const std::uint64_t> cellHashes) {
+    std::uint64_t h = mixHash(cellHashes.size());
+    for (std::uint64_t cellHash: cellHashes) {
+        h = combineHash(h, cellHash);
+    }
+    return h;
+}
+
+//! 64-bit hash of a whole grid (same value as hashCells over the hash of each cell)
+inline std::uint64_t hashGrid(std::span<const playerState> grid) {
+    std::uint64_t h = mixHash(grid.size());
+    for (const auto& state: grid) {
+        h = combineHash(h, hashState(state));
+    }
+    return h;
+}
+
+#endif // STATE_HASH_HPP
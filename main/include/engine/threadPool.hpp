@@ -0,0 +1,104 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Fixed set of worker threads that run parallel loops (the calling thread takes part in every loop)
+//! The workers are started once and sleep between loops, so a loop costs a wake-up instead of a thread creation.
+class ThreadPool {
+    using Body = std::function<void(int first, int last)>;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;           // a new loop was posted (or the pool is stopping)
+    std::condition_variable done;           // every worker finished the current loop
+    const Body* body;                       // body of the current loop
+    int count;                              // iterations of the current loop
+    int grain;                              // iterations taken at once
+    std::atomic<int> nextIteration;
+    long generation;                        // number of loops posted so far
+    int busy;                               // workers still running the current loop
+    bool stopping;
+
+    //! Runs chunks of the current loop until every iteration was taken
+    void runChunks() {
+        for (int first = nextIteration.fetch_add(grain); first < count; first = nextIteration.fetch_add(grain)) {
+            (*body)(first, std::min(first + grain, count));
+        }
+    }
+
+    void workerLoop() {
+        long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            runChunks();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    public:
+    //! Creates a pool of threads threads in total (threads - 1 workers plus the calling thread)
+    explicit ThreadPool(unsigned threads): body(nullptr), count(0), grain(1), nextIteration(0), generation(0), busy(0), stopping(false) {
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker: workers) {
+            worker.join();
+        }
+    }
+
+    [[nodiscard]] unsigned size() const {
+        return static_cast<unsigned>(workers.size()) + 1;
+    }
+
+    //! Calls loopBody on chunks of [0, iterations) from every thread and returns once all of them are done
+    void parallelFor(int iterations, const Body& loopBody) {
+        if (workers.empty() || iterations <= 1) {
+            loopBody(0, iterations);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            body = &loopBody;
+            count = iterations;
+            grain = std::max(1, iterations / static_cast<int>(4 * size()));
+            nextIteration.store(0);
+            busy = static_cast<int>(workers.size());
+            ++generation;
+        }
+        wake.notify_all();
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return busy == 0; });
+    }
+};
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,772 @@
+#ifndef PLAYER_RULES_HPP
+#define PLAYER_RULES_HPP
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include "playerState.hpp"
+#include "data_structures/philox.hpp"
+#include "data_structures/utils.hpp"
+
+struct NeighborFlags {
+    // check for empty
+    bool north_empty = false;                   // check if north cell (i-1, j) empty
+    bool south_empty = false;                   // check if south cell (i+1, j) empty
+    bool east_empty = false;                    // check if east cell (i, j+1) empty
+    bool west_empty = false;                    // check if west cell (i, j-1) empty
+
+    // check for obstacle
+    bool obstacle_interception_north = false;   // check if north neighbor is an obstacle (can intercept long pass)
+    bool obstacle_interception_south = false;   // check if south neighbor is an obstacle (can intercept long pass)
+
+    // check for neighbor being near an obstacle
+    bool near_west_obstacle = false;
+    bool near_east_obstacle = false;
+    bool near_north_obstacle = false;
+    bool near_south_obstacle = false;
+
+    // check for teammate
+    bool west_teammate = false;                 // check if west cell (i, j-1) has player
+    bool east_teammate = false;                 // check if east cell (i, j+1) has player
+    bool north_teammate = false;                // check if north cell (i-1, j) has player
+    bool south_teammate = false;                // check if south cell (i+1, j) has player
+
+    bool north_extended_teammate = false;       // check if north cell (i-2, j) has player (extended von Neumann)
+    bool south_extended_teammate = false;       // check if south cell (i+2, j) has player (extended von Neumann)
+
+    // track player action for MOVE
+    bool north_dribble = false;                 // flag for neighbor (east or west) dribbles north
+    bool south_dribble = false;                 // flag for neighbor (east or west) dribbles south
+
+    // track incoming players from dribbling/moving and balls from passing for delayed propagation
+    bool dribble_from_south = false;            // flag for south cell wants to dribble north
+    bool move_from_south = false;               // flag for south cell wants to move north
+
+    bool dribble_from_north = false;            // flag for north cell wants to dribble south
+    bool move_from_north = false;               // flag for north cell wants to move south
+
+    bool dribble_from_east = false;            // flag for east cell wants to dribble west
+    bool move_from_east = false;               // flag for east cell wants to move west
+
+    bool dribble_from_west = false;            // flag for west cell wants to dribble east
+    bool move_from_west = false;               // flag for west cell wants to move east
+
+    bool short_pass_from_east = false;          // flag for east cell wants to short pass west
+    bool short_pass_from_west = false;          // flag for west cell wants to short pass east
+
+    bool long_pass_from_north = false;          // flag for north cell wants to long pass south
+    bool long_pass_from_south = false;          // flag for south cell wants to long pass north
+    bool extended_long_pass_from_north = false; // flag for extended north cell wants to long pass south
+    bool extended_long_pass_from_south = false; // flag for extended south cell wants to long pass north
+};
+
+//! Attributes inherited by an empty cell when a neighbor player dribbles/moves into it
+struct SourcePlayer {
+    double mental = 50.0;
+    double fatigue = 0.0;
+    int initial_row = 0;
+    ZoneType zone_type = ZoneType::NONE;
+};
+
+struct PlayerRoleWeight {
+    double passWeight;
+    double dribbleWeight;
+
+    explicit PlayerRoleWeight(): passWeight(1.0), dribbleWeight(1.0) {}
+
+    PlayerRoleWeight(double p, double d): passWeight(p), dribbleWeight(d) {}
+};
+
+const std::unordered_map<PlayerRole, PlayerRoleWeight> playerRoleWeights = {
+    {PlayerRole::NONE,           {1.0, 1.0}},
+    {PlayerRole::CENTERBACK,     {1.3, 0.7}},
+    {PlayerRole::FULLBACK,       {0.9, 1.1}},
+    {PlayerRole::PLAYMAKER,      {1.4, 0.6}},
+    {PlayerRole::WINGER,         {0.6, 1.4}},
+    {PlayerRole::TARGET_FORWARD, {0.8, 1.2}},
+    {PlayerRole::FALSE_NINE,     {1.2, 0.8}}
+};
+
+//! Relative neighbors read by the player rules (von Neumann range 2, only the north/south extension is used)
+enum NeighborSlot {
+    NORTH_SLOT,             // (i-1, j)
+    SOUTH_SLOT,             // (i+1, j)
+    EAST_SLOT,              // (i, j+1)
+    WEST_SLOT,              // (i, j-1)
+    NORTH_EXTENDED_SLOT,    // (i-2, j)
+    SOUTH_EXTENDED_SLOT,    // (i+2, j)
+    NEIGHBOR_SLOTS
+};
+
+//! Relative offsets {row, col} of every neighbor slot
+constexpr std::array<std::array<int, 2>, NEIGHBOR_SLOTS> neighborOffsets = {{
+    {-1, 0}, {1, 0}, {0, 1}, {0, -1}, {-2, 0}, {2, 0}
+}};
+
+//! Neighbor states indexed by NeighborSlot (nullptr when the neighbor is outside the grid or the neighborhood)
+using NeighborStates = std::array<const playerState*, NEIGHBOR_SLOTS>;
+
+//! Coordinates {row, col} of the neighbor of (row, col) in a slot, counted from the first cell of the grid
+//! On toroidal (wrapped) grids they wrap around the edges; otherwise std::nullopt if the neighbor is outside the grid.
+//! The extended slots are only part of the neighborhood from range 2. Every engine and the Cadmium cell locate their
+//! neighbors with it, so they agree on wrapped grids.
+inline std::optional<std::array<int, 2>> neighborCoordinates(int row, int col, int slot, int rows, int cols, bool wrapped, int range) {
+    if (slot >= NORTH_EXTENDED_SLOT && range < 2) {
+        return std::nullopt;
+    }
+    int r = row + neighborOffsets[slot][0];
+    int c = col + neighborOffsets[slot][1];
+    if (wrapped) {
+        r = (r % rows + rows) % rows;
+        c = (c % cols + cols) % cols;
+    } else if (r < 0 || r >= rows || c < 0 || c >= cols) {
+        return std::nullopt;
+    }
+    return std::array<int, 2>{r, c};
+}
+
+//! Cell ids of the neighbors of a Cadmium grid cell in every slot, to pick the rule neighbors out of its neighborhood
+//! map (the ids include the scenario origin, like Cadmium's coordinates)
+class NeighborSlotIds {
+    std::array<std::optional<std::array<int, 2>>, NEIGHBOR_SLOTS> ids;
+
+    public:
+    NeighborSlotIds(int row, int col, int originRow, int originCol, int rows, int cols, bool wrapped, int range) {
+        for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+            ids[slot] = neighborCoordinates(row - originRow, col - originCol, slot, rows, cols, wrapped, range);
+            if (ids[slot]) {
+                (*ids[slot])[0] += originRow;
+                (*ids[slot])[1] += originCol;
+            }
+        }
+    }
+
+    //! Rule neighbors of a neighborhood map {cell id: neighbor data} (stateOf gives the state of a neighbor data)
+    //! The map order does not matter. On a small wrapped grid one neighbor (or the cell itself) can fill several slots.
+    template <typename Neighborhood, typename StateOf>
+    [[nodiscard]] NeighborStates gather(const Neighborhood& neighborhood, StateOf stateOf) const {
+        NeighborStates neighbors{};
+        for (const auto& [neighborId, neighborData]: neighborhood) {
+            for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+                if (ids[slot] && neighborId[0] == (*ids[slot])[0] && neighborId[1] == (*ids[slot])[1]) {
+                    neighbors[slot] = stateOf(neighborData);
+                }
+            }
+        }
+        return neighbors;
+    }
+};
+
+//////////////////////////////////////////////////////////////
+// Helper functions (for data collection)
+//////////////////////////////////////////////////////////////
+inline bool isEmpty(const playerState& s) {
+    return (!s.has_player) && (!s.has_ball) && (!s.has_obstacle);
+}
+
+inline bool isTeammate(const playerState& s) {
+    return (s.has_player) && (!s.has_ball);
+}
+
+inline bool isObstacle(const playerState& s) {
+    return (!s.has_player) && (!s.has_ball) && (s.has_obstacle);
+}
+
+inline bool isActionFromDirection(const playerState& s, Action a, Direction d) {
+    return (s.action == a) && (s.direction == d);
+}
+
+//! A cell the player rules leave unchanged while no direct neighbor has an obstacle or an action: no player, ball or
+//! obstacle, no pending action, and mental and fatigue already inside their clamping range (an empty cell only reacts
+//! to neighbors that dribble/move into it or hold an obstacle)
+inline bool isQuiet(const playerState& s) {
+    return !s.has_player && !s.has_ball && !s.has_obstacle && s.action == Action::NONE &&
+           s.mental >= 0.0 && s.mental <= 100.0 && s.fatigue >= 0.0 && s.fatigue <= 100.0;
+}
+
+//! A cell the player rules leave unchanged: quiet, no rule neighbor (range 2) with a pending action and no direct
+//! neighbor with an obstacle
+inline bool isPassive(const playerState& state, const NeighborStates& neighbors) {
+    if (!isQuiet(state)) {
+        return false;
+    }
+    for (int slot = 0; slot < NEIGHBOR_SLOTS; ++slot) {
+        const playerState* n = neighbors[slot];
+        if (n != nullptr && (n->action != Action::NONE || (slot < NORTH_EXTENDED_SLOT && n->has_obstacle))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Collects the emptiness and teammate flags of a cell (the occupancy flags that change as players move)
+inline void collectVacancyFlags(const NeighborStates& neighbors, NeighborFlags& flags) {
+    if (const playerState* n = neighbors[NORTH_SLOT]) {
+        // check north cell emptiness (to dribble/move forward)
+        flags.north_empty = isEmpty(*n);
+        // check for direct north teammate
+        flags.north_teammate = isTeammate(*n);
+    }
+    if (const playerState* n = neighbors[WEST_SLOT]) {
+        // check west cell emptiness (to dribble/move left)
+        flags.west_empty = isEmpty(*n);
+        // check for teammates in same line (left)
+        flags.west_teammate = isTeammate(*n);
+    }
+    if (const playerState* n = neighbors[EAST_SLOT]) {
+        // check east cell emptiness (to dribble/move right)
+        flags.east_empty = isEmpty(*n);
+        // check for teammates in same line (right)
+        flags.east_teammate = isTeammate(*n);
+    }
+    if (const playerState* n = neighbors[SOUTH_SLOT]) {
+        // check south cell emptiness (to dribble/move backward)
+        flags.south_empty = isEmpty(*n);
+        // check for direct south teammate
+        flags.south_teammate = isTeammate(*n);
+    }
+    if (const playerState* n = neighbors[NORTH_EXTENDED_SLOT]) {
+        // check for extended north teammate
+        flags.north_extended_teammate = isTeammate(*n);
+    }
+    if (const playerState* n = neighbors[SOUTH_EXTENDED_SLOT]) {
+        // check for extended south teammate
+        flags.south_extended_teammate = isTeammate(*n);
+    }
+}
+
+//! Collects the obstacle flags of a cell: obstacle interception and near-obstacle neighbors
+//! (it also raises state.near_obstacle if a direct neighbor has an obstacle)
+//! Obstacles never move, so an engine may precompute these flags instead (see ObstacleField)
+inline void collectObstacleFlags(playerState& state, const NeighborStates& neighbors, NeighborFlags& flags) {
+    if (const playerState* n = neighbors[NORTH_SLOT]) {
+        // North neighbor has an obstacle (can intercept long pass)
+        flags.obstacle_interception_north = isObstacle(*n);
+        flags.near_north_obstacle = n->near_obstacle;
+    }
+    if (const playerState* n = neighbors[WEST_SLOT]) {
+        flags.near_west_obstacle = n->near_obstacle;
+    }
+    if (const playerState* n = neighbors[EAST_SLOT]) {
+        flags.near_east_obstacle = n->near_obstacle;
+    }
+    if (const playerState* n = neighbors[SOUTH_SLOT]) {
+        // South neighbor has an obstacle (can intercept long pass)
+        flags.obstacle_interception_south = isObstacle(*n);
+        flags.near_south_obstacle = n->near_obstacle;
+    }
+
+    // if any direct neighbor has an obstacle, we toggle state flag to broadcast that we are near an obstacle
+    for (int slot: {NORTH_SLOT, WEST_SLOT, EAST_SLOT, SOUTH_SLOT}) {
+        if (neighbors[slot] != nullptr && neighbors[slot]->has_obstacle) {
+            state.near_obstacle = true;
+        }
+    }
+}
+
+//! Collects the occupancy flags of a cell: emptiness, teammates, obstacles and near-obstacle neighbors
+//! (it also raises state.near_obstacle if a direct neighbor has an obstacle)
+//! These flags only depend on has_player, has_ball, has_obstacle and near_obstacle of the neighbors, so an engine may
+//! compute them from occupancy bitboards instead (see OccupancyBitboard)
+inline void collectOccupancyFlags(playerState& state, const NeighborStates& neighbors, NeighborFlags& flags) {
+    collectVacancyFlags(neighbors, flags);
+    collectObstacleFlags(state, neighbors, flags);
+}
+
+//! Collects the action flags of a cell: incoming dribbles, moves and passes, and the player a moving cell inherits from
+//! Neighbors are visited in a fixed order (north, west, east, south, extended) so the result does not depend on
+//! how the caller stores its neighborhood
+inline void collectActionFlags(const NeighborStates& neighbors, NeighborFlags& flags, SourcePlayer& source) {
+    // get source player metrics for inheritance by new cell
+    auto inheritFrom = [&source](const playerState& n) {
+        source.mental = n.mental;
+        source.fatigue = n.fatigue;
+        source.initial_row = n.initial_row;
+        source.zone_type = n.zone_type;
+    };
+
+    if (const playerState* n = neighbors[NORTH_SLOT]) {
+        // if my direct north neighbor has an action to long pass to south (me) then i should receive ball
+        flags.long_pass_from_north = isActionFromDirection(*n, Action::LONG_PASS, Direction::SOUTH);
+        // record player action
+        flags.dribble_from_north = isActionFromDirection(*n, Action::DRIBBLE, Direction::SOUTH);  // North cell (i-1, j) wants to dribble backward
+        flags.move_from_north = isActionFromDirection(*n, Action::MOVE, Direction::SOUTH);        // North cell (i-1, j) wants to move backward
+        if (flags.dribble_from_north || flags.move_from_north) {
+            inheritFrom(*n);
+        }
+    }
+    if (const playerState* n = neighbors[WEST_SLOT]) {
+        // if my direct west neighbor has an action to short pass to east (me) then i should receive ball
+        flags.short_pass_from_west = isActionFromDirection(*n, Action::SHORT_PASS, Direction::EAST);
+        // record player action
+        flags.dribble_from_west = isActionFromDirection(*n, Action::DRIBBLE, Direction::EAST);   // West cell (i, j-1) wants to dribble right
+        flags.move_from_west = isActionFromDirection(*n, Action::MOVE, Direction::EAST);         // West cell (i, j-1) wants to move right
+        if (flags.dribble_from_west || flags.move_from_west) {
+            inheritFrom(*n);
+        }
+    }
+    if (const playerState* n = neighbors[EAST_SLOT]) {
+        // if my direct east neighbor has an action to short pass to west (me) then i should receive ball
+        flags.short_pass_from_east = isActionFromDirection(*n, Action::SHORT_PASS, Direction::WEST);
+        // record player action
+        flags.dribble_from_east = isActionFromDirection(*n, Action::DRIBBLE, Direction::WEST);   // East cell (i, j+1) wants to dribble left
+        flags.move_from_east = isActionFromDirection(*n, Action::MOVE, Direction::WEST);         // East cell (i, j+1) wants to move left
+        if (flags.dribble_from_east || flags.move_from_east) {
+            inheritFrom(*n);
+        }
+    }
+    if (const playerState* n = neighbors[SOUTH_SLOT]) {
+        // if my direct south neighbor has an action to long pass to north (me) then i should receive ball
+        flags.long_pass_from_south = isActionFromDirection(*n, Action::LONG_PASS, Direction::NORTH);
+        // record player action
+        flags.dribble_from_south = isActionFromDirection(*n, Action::DRIBBLE, Direction::NORTH);  // South cell (i+1, j) wants to dribble forward
+        flags.move_from_south = isActionFromDirection(*n, Action::MOVE, Direction::NORTH);        // South cell (i+1, j) wants to move forward
+        if (flags.dribble_from_south || flags.move_from_south) {
+            inheritFrom(*n);
+        }
+    }
+    if (const playerState* n = neighbors[NORTH_EXTENDED_SLOT]) {
+        // if my extended north neighbor has an action to long pass to south (me) then i should receive ball
+        flags.extended_long_pass_from_north = isActionFromDirection(*n, Action::LONG_PASS, Direction::SOUTH);
+    }
+    if (const playerState* n = neighbors[SOUTH_EXTENDED_SLOT]) {
+        // if my extended south neighbor has an action to long pass to north (me) then i should receive ball
+        flags.extended_long_pass_from_south = isActionFromDirection(*n, Action::LONG_PASS, Direction::NORTH);
+    }
+
+    // East or West neighbor performs a dribble (to allow for move action)
+    // each neighbor overwrites the flags and they are visited west then east, so east decides (model decision: the
+    // original cell visited them in unordered_map order, which changed from cell to cell)
+    for (const playerState* n: {neighbors[WEST_SLOT], neighbors[EAST_SLOT]}) {
+        if (n != nullptr) {
+            flags.north_dribble = isActionFromDirection(*n, Action::DRIBBLE, Direction::NORTH);   // Neighbor cell (west or east - same line) performs a dribble north
+            flags.south_dribble = isActionFromDirection(*n, Action::DRIBBLE, Direction::SOUTH);   // Neighbor cell (west or east - same line) performs a dribble south
+        }
+    }
+}
+
+//! Collects the neighbor flags of a cell (it also raises state.near_obstacle if a direct neighbor has an obstacle)
+inline NeighborFlags collectNeighborFlags(playerState& state, const NeighborStates& neighbors, SourcePlayer& source) {
+    NeighborFlags flags;
+    collectOccupancyFlags(state, neighbors, flags);
+    collectActionFlags(neighbors, flags, source);
+    return flags;
+}
+
+//! Picks one option of a rule with several equally valid directions
+//! Deterministic mode keeps the rule priority (first valid option); stochastic mode breaks the tie uniformly
+inline Direction pickDirection(std::initializer_list<std::pair<bool, Direction>> options, DecisionSampler* sampler) {
+    int valid = 0;
+    for (const auto& [ok, direction]: options) {
+        valid += ok ? 1 : 0;
+    }
+    if (valid == 0) {
+        return Direction::NONE;
+    }
+
+    int chosen = (sampler != nullptr) ? std::min(static_cast<int>(sampler->uniform() * valid), valid - 1) : 0;
+    for (const auto& [ok, direction]: options) {
+        if (ok && chosen-- == 0) {
+            return direction;
+        }
+    }
+    return Direction::NONE;
+}
+
+//! Applies the player rules to a cell given its collected neighbor flags
+//! With a sampler the ball carrier draws its action (pass versus dribble weighted by role, mental and fatigue)
+//! and ties between valid directions are broken at random; without one the threshold rules are applied as is
+inline playerState applyPlayerRules(playerState state, const NeighborFlags& flags, const SourcePlayer& source, int row, DecisionSampler* sampler = nullptr) {
+    //////////////////////////////////////////////////////////////
+    // Helper functions (for local computation rules)
+    //////////////////////////////////////////////////////////////
+    auto applyHoldActionPlusCost = [&state]() {      // use lambda to capture reference to playerState
+        state.action = Action::HOLD;
+        state.direction = Direction::NONE;
+
+        state.fatigue += 2.0;
+        state.mental -= 1.0;
+    };
+
+    auto applyShortPassActionPlusCost = [&state](Direction direction) {    // take in parameter and capture reference to playerState
+        state.action = Action::SHORT_PASS;
+        state.direction = direction;
+        // ball transfered to target cell after delay
+        state.has_ball = false;
+        // action cost -> mental/fatigue fluctuations
+        state.fatigue += 3.0;
+        state.mental -= 1.5;
+    };
+
+    auto applyLongPassActionPlusCost = [&state](Direction direction) {    // take in parameter and capture reference to playerState
+        state.action = Action::LONG_PASS;
+        state.direction = direction;
+        // ball transfered to target extended cell after delay
+        state.has_ball = false;
+        // action cost -> mental/fatigue fluctuations
+        state.fatigue += 4.0;
+        state.mental -= 2.5;
+    };
+
+    auto applyDribbleAction = [&state](Direction direction) {    // take in parameter and capture reference to playerState
+        state.action = Action::DRIBBLE;
+        state.direction = direction;
+        // ball and player transfered to target cell after delay
+        state.has_player = false;
+        state.has_ball = false;
+    };
+
+    auto applyMoveAction = [&state](Direction direction) {    // take in parameter and capture reference to playerState
+        state.action = Action::MOVE;
+        state.direction = direction;
+        // player transfered to target cell after delay
+        state.has_player = false;
+    };
+
+    auto applyBecomePlayerFromDribblePlusCost = [&state, &source]() { // use lambda to capture reference to playerState and source attributes
+        state.has_player = true;
+        state.has_ball = true;
+        // Inherit player attributes from source and apply action cost (mental/fatigue fluctuations)
+        state.mental = source.mental - 3.0;
+        state.fatigue = source.fatigue + 7.0;
+        state.initial_row = source.initial_row;
+        state.zone_type = source.zone_type;
+    };
+
+    auto applyBecomePlayerFromMovePlusCost = [&state, &source]() { // use lambda to capture reference to playerState
+        state.has_player = true;
+        // inherit player attributes from source and apply action cost (mental/fatigue fluctuations)
+        state.mental = source.mental - 2.0;
+        state.fatigue = source.fatigue + 5.0;
+        state.initial_row = source.initial_row;
+        state.zone_type = source.zone_type;
+    };
+
+    auto applyGetBallFromShortPassPlusCost = [&state]() { // use lambda to capture reference to playerState
+        state.has_ball = true;
+        // action cost -> mental/fatigue fluctuations
+        state.mental -= 1.0;
+        state.fatigue += 2.5;
+    };
+
+    auto applyGetBallFromLongPassPlusCost = [&state]() { // use lambda to capture reference to playerState
+        state.has_ball = true;
+        // action cost -> mental/fatigue fluctuations
+        state.mental -= 2.0;
+        state.fatigue += 3.5;
+    };
+
+    auto applyMentalFatigueRecovery = [&state]() { // use lambda to capture reference to playerState
+        state.action = Action::NONE;               // Reset action
+        state.direction = Direction::NONE;         // Reset direction
+        state.mental += 1.0;
+        state.fatigue -= 1.0;
+    };
+
+    auto resetAll = [&state]() {                // use lambda to capture reference to playerState
+        state.mental = 50.0;
+        state.fatigue = 0.0;
+        state.action = Action::NONE;
+        state.direction = Direction::NONE;
+        state.inactive_time = 0;
+    };
+
+    auto resetActionAndDirection = [&state]() { // use lambda to capture reference to playerState
+        state.action = Action::NONE;            // Reset action
+        state.direction = Direction::NONE;      // Reset direction
+    };
+
+    // Moves the player if a direction was picked (returns whether it moved)
+    auto tryMove = [&applyMoveAction](Direction direction) {
+        if (direction == Direction::NONE) {
+            return false;
+        }
+        applyMoveAction(direction);
+        return true;
+    };
+
+    //////////////////////////////////////////////////////////////
+    // Perform Actions (Cell logic when having ball)
+    //////////////////////////////////////////////////////////////
+    if (state.has_player && state.has_ball && sampler != nullptr) {
+        auto weights = playerRoleWeights.at(state.player_role);
+
+        double confidence = state.mental / 100.0;       // high mental favours long passes and dribbles
+        double freshness = 1.0 - state.fatigue / 100.0; // low fatigue favours dribbles
+
+        // Rules 1-4 as weighted options: every feasible (action, direction) competes, hold is always feasible
+        struct Option { Action action; Direction direction; double weight; };
+        std::array<Option, 9> options{};
+        int count = 0;
+        double total = 0.0;
+        auto addOptions = [&options, &count, &total](Action action, double weight, std::initializer_list<std::pair<bool, Direction>> directions) {
+            int valid = 0;
+            for (const auto& [ok, direction]: directions) {
+                valid += ok ? 1 : 0;
+            }
+            for (const auto& [ok, direction]: directions) {
+                if (ok && weight > 0.0) {
+                    options[count++] = {action, direction, weight / valid};     // split evenly: random tie-breaking
+                    total += weight / valid;
+                }
+            }
+        };
+
+        addOptions(Action::SHORT_PASS, weights.passWeight * (1.0 - confidence), {
+            {flags.east_teammate && !flags.near_east_obstacle, Direction::EAST},
+            {flags.west_teammate && !flags.near_west_obstacle, Direction::WEST}
+        });
+        addOptions(Action::LONG_PASS, weights.passWeight * confidence, {
+            {(flags.north_extended_teammate || flags.north_teammate) && !flags.obstacle_interception_north, Direction::NORTH},
+            {(flags.south_extended_teammate || flags.south_teammate) && !flags.obstacle_interception_south, Direction::SOUTH}
+        });
+        addOptions(Action::DRIBBLE, weights.dribbleWeight * confidence * freshness, {
+            {flags.north_empty, Direction::NORTH},
+            {flags.east_empty, Direction::EAST},
+            {flags.south_empty, Direction::SOUTH},
+            {flags.west_empty, Direction::WEST}
+        });
+        addOptions(Action::HOLD, 0.05 + (1.0 - freshness), {{true, Direction::NONE}});
+
+        double target = sampler->uniform() * total;
+        Option chosen = options[count - 1];
+        for (int i = 0; i < count; ++i) {
+            if (target < options[i].weight) {
+                chosen = options[i];
+                break;
+            }
+            target -= options[i].weight;
+        }
+
+        switch (chosen.action) {
+            case Action::SHORT_PASS: applyShortPassActionPlusCost(chosen.direction); break;
+            case Action::LONG_PASS:  applyLongPassActionPlusCost(chosen.direction); break;
+            case Action::DRIBBLE:    applyDribbleAction(chosen.direction); break;
+            default:                 applyHoldActionPlusCost(); break;
+        }
+    }
+    else if (state.has_player && state.has_ball) {
+        auto weights = playerRoleWeights.at(state.player_role);
+
+        auto fatiguePass = state.fatigue / weights.passWeight;
+        auto mentalPass  = state.mental  / weights.passWeight;
+
+        auto fatigueDribble = state.fatigue / weights.dribbleWeight;
+        auto mentalDribble  = state.mental  / weights.dribbleWeight;
+
+        // Rule 1: Short pass to west or east teammate not near an obstacle
+        if (fatiguePass > 20.0 && fatiguePass < 65.0 && mentalPass < 65.0) {
+            if (flags.east_teammate && !flags.near_east_obstacle) {
+                applyShortPassActionPlusCost(Direction::EAST);
+            }
+            else if (flags.west_teammate && !flags.near_west_obstacle) {
+                applyShortPassActionPlusCost(Direction::WEST);
+            }
+            else {
+                // Rule 4: Can't perform action -> hold the ball
+                applyHoldActionPlusCost();
+            }
+        }
+        // Rule 2: Long pass to north or south teammate (includes extended teammate) - be wary of obstacle interception
+        else if (fatiguePass > 20.0 && mentalPass > 65.0 && mentalPass <= 75.0) {
+            if ((flags.north_extended_teammate || flags.north_teammate) && !flags.obstacle_interception_north) {
+                applyLongPassActionPlusCost(Direction::NORTH);
+            }
+            else if ((flags.south_extended_teammate || flags.south_teammate) && !flags.obstacle_interception_south) {
+                applyLongPassActionPlusCost(Direction::SOUTH);
+            }
+            else {
+                // Rule 4: Can't perform action -> hold the ball
+                applyHoldActionPlusCost();
+            }
+        }
+        // Rule 3: Dribble north/east/south/west if possible
+        else if (fatigueDribble < 40.0 && mentalDribble >= 60.0) {
+            if (flags.north_empty) {
+                applyDribbleAction(Direction::NORTH);
+            }
+            else if (flags.east_empty) {
+                applyDribbleAction(Direction::EAST);
+            }
+            else if (flags.south_empty) {
+                applyDribbleAction(Direction::SOUTH);
+            }
+            else if (flags.west_empty) {
+                applyDribbleAction(Direction::WEST);
+            }
+            else {
+                // Rule 4: Can't perform action
+                applyHoldActionPlusCost();
+            }
+        }
+        // Rule 4: Hold the ball
+        else {
+            // action cost -> mental/fatigue fluctuations
+            applyHoldActionPlusCost();
+        }
+
+    }
+    else if (state.has_player && !state.has_ball) {
+        // Rule 5: Off-ball movement
+        bool moved = false;
+
+        // Move north/south if possible when neighbor dribbles (Follow neighbor movement)
+        if (state.fatigue < 40.0 && state.mental > 50.0) {
+            moved = tryMove(pickDirection({
+                {flags.north_empty && flags.north_dribble, Direction::NORTH},
+                {flags.south_empty && flags.south_dribble, Direction::SOUTH}
+            }, sampler));
+        }
+
+        /*
+        Defenders: Off-ball movement is specific to tracking back.
+            - Any defender who is out of position should attempt to return to their defensive line (initial_row)
+            - If by any chance original location is blocked by an obstacle, defender will drop back to original
+            - Defenders will not be moving when detecting their neighbor dribbled
+
+            Goal: Hold defensive line
+        */
+        if (!moved && state.zone_type == ZoneType::DEFENSE) {
+            bool isDisplaced = row != state.initial_row;
+
+            if (isDisplaced) {
+                // Defender is above initial row => should move south
+                if (flags.south_empty && row < state.initial_row) {
+                    applyMoveAction(Direction::SOUTH);
+                    moved = true;
+                }
+                // Defender is below initial row => should move north
+                else if (flags.north_empty && row > state.initial_row) {
+                    applyMoveAction(Direction::NORTH);
+                    moved = true;
+                }
+                // Try moving left/right since north/south not possible
+                else if (flags.west_empty || flags.east_empty) {
+                    moved = tryMove(pickDirection({
+                        {flags.west_empty, Direction::WEST},
+                        {flags.east_empty, Direction::EAST}
+                    }, sampler));
+                }
+                else {
+                    resetActionAndDirection(); // No valid repositioning
+                }
+            }
+        }
+        /*
+        Midfielders: Off-ball movement is specific to being open for a pass.
+            - If midfielder didn't move but sees that he is near obstacle, will try to reposition himself
+            to an open cell (without obstacles)
+
+            Goal: Remain as an open passing option
+        */
+        else if (!moved && state.zone_type == ZoneType::MIDFIELD) {
+            // Unable to move -> try reposititioning if near obstacle
+            if (!moved && state.near_obstacle) {
+                // try moving left/right first to open space
+                moved = tryMove(pickDirection({
+                    {flags.west_empty && !flags.near_west_obstacle, Direction::WEST},
+                    {flags.east_empty && !flags.near_east_obstacle, Direction::EAST}
+                }, sampler));
+                // not successful, try moving up/down
+                if (!moved) {
+                    moved = tryMove(pickDirection({
+                        {flags.north_empty && !flags.near_north_obstacle, Direction::NORTH},
+                        {flags.south_empty && !flags.near_south_obstacle, Direction::SOUTH}
+                    }, sampler));
+                }
+            }
+        }
+        /*
+        Attackers: Off-ball movement is tied to remaining forward and in open positions in attacking positions
+            - If they by any chance drifted backwards, track back to initial row (similar to defender repositioning)
+            - If there is an obstacle in front or cell in front is near obstacle, try to break away wide (move left-right)
+
+            Goal: Stay forward and be in good attacking positions
+        */
+        else if (!moved && state.zone_type == ZoneType::ATTACK) {
+            // Attacker below his initial row => should move north
+            if (flags.north_empty && row > state.initial_row) {
+                applyMoveAction(Direction::NORTH);
+                moved = true;
+            }
+            // near an obstacle => try moving wide for a better attacking positioning
+            else if (flags.near_north_obstacle || flags.obstacle_interception_north) {
+                // try move left or right first
+                moved = tryMove(pickDirection({
+                    {flags.west_empty, Direction::WEST},
+                    {flags.east_empty, Direction::EAST}
+                }, sampler));
+                // not possible -> drop back and try from there
+                if (!moved && flags.south_empty) {
+                    applyMoveAction(Direction::SOUTH);
+                    moved = true;
+                }
+            }
+        }
+
+        // Rule 6: Player Recovers Mental/Fatigue if he performs no actions
+        if (!moved) {
+            applyMentalFatigueRecovery();
+        }
+    }
+
+    //////////////////////////////////////////////////////////////
+    // Receive Actions (Delayed Cell Neighbor Inputs)
+    //////////////////////////////////////////////////////////////
+    if (!state.has_player && !state.has_ball && !state.has_obstacle) {  // empty cell (no player, ball, or obstacle)
+        // Case 1: Become a player w/ ball if south/north/west/east neighbor wants to dribble to your location
+        if (flags.dribble_from_south || flags.dribble_from_north || flags.dribble_from_west || flags.dribble_from_east) {
+            applyBecomePlayerFromDribblePlusCost();
+        }
+        // Case 2: Become a player w/o ball if west/east neighbor dribbles (move north/south with player dribbling) or for off-ball movement
+        else if (flags.move_from_south || flags.move_from_north || flags.move_from_west || flags.move_from_east) {
+            applyBecomePlayerFromMovePlusCost();
+        }
+    }
+    else if (state.has_player && !state.has_ball) {     // player cell
+        // Case 3: Become a player w/ ball when neighbor performs a short pass
+        if (flags.short_pass_from_west || flags.short_pass_from_east) {
+            applyGetBallFromShortPassPlusCost();
+        }
+        // Case 4: Become a player w/ ball when neighbor performs long pass
+        else if (flags.long_pass_from_north || flags.long_pass_from_south) {
+            applyGetBallFromLongPassPlusCost();
+        }
+        else if (flags.extended_long_pass_from_north || flags.extended_long_pass_from_south) {
+            applyGetBallFromLongPassPlusCost();
+        }
+    }
+
+    //////////////////////////////////////////////////////////////
+    // Cleanup of cells that moved (action = dribble or move)
+    //////////////////////////////////////////////////////////////
+    if (!state.has_player && !state.has_ball && !state.has_obstacle) {
+        // Only track cells that had actions
+        if (state.action != Action::NONE) {
+            state.inactive_time += 1;
+
+            // Reset after 1 inactive timestep with action
+            if (state.inactive_time >= 2) {
+                resetAll();
+            }
+        }
+    } else {
+        state.inactive_time = 0; // Reset for active cells
+    }
+
+    // Clamp metrics
+    state.fatigue = std::clamp(state.fatigue, 0.0, 100.0);
+    state.mental = std::clamp(state.mental, 0.0, 100.0);
+
+    return state;
+}
+
+//! Full cell transition: data collection followed by the player rules
+inline playerState playerTransition(playerState state, const NeighborStates& neighbors, int row, DecisionSampler* sampler = nullptr) {
+    SourcePlayer source;
+    NeighborFlags flags = collectNeighborFlags(state, neighbors, source);
+    return applyPlayerRules(state, flags, source, row, sampler);
+}
+
+#endif // PLAYER_RULES_HPP
@@ -38,14 +38,14 @@ struct playerState {
 };
 
 //! It prints the state variables of the cell in an output stream
-std::ostream& operator<<(std::ostream& os, const playerState& x) {
+inline std::ostream& operator<<(std::ostream& os, const playerState& x) {
     // os << "{has_player: " << ((x.has_player) ? 1 : 0) << ", has_ball: " << ((x.has_ball) ? 1 : 0) << ", has_obstacle: " << ((x.has_obstacle) ? 1 : 0) << ", near_obstacle: " << ((x.near_obstacle) ? 1 : 0) << ", mental: " << x.mental << ", fatigue: " << x.fatigue << ", action: " << x.action << ", direction: " << x.direction << ", zone_type: " << x.zone_type << ", player_role: " << x.player_role << ", initial_row: " << x.initial_row << ", inactive_time: " << x.inactive_time << "}"; // use this output if you want clarity on the grid log csv file
     os << "<" << ((x.has_player) ? 1 : 0) << "," << ((x.has_ball) ? 1 : 0) << "," << ((x.has_obstacle) ? 1 : 0) << "," << ((x.near_obstacle) ? 1 : 0) << "," << x.mental << "," << x.fatigue << "," << x.action << "," << x.direction << "," << x.zone_type << "," << x.player_role << "," << x.initial_row << "," << x.inactive_time << ">";  // use this output when you need to use the Cell-DEVS viewer
     return os;
 }
 
 //! The simulator must be able to compare the equality of two state objects
-bool operator!=(const playerState& x, const playerState& y) {
+inline bool operator!=(const playerState& x, const playerState& y) {
     return (
         (x.has_player != y.has_player) || 
         (x.has_ball != y.has_ball) || 
@@ -63,12 +63,12 @@ bool operator!=(const playerState& x, const playerState& y) {
 }
 
 //! The simulator must be able to sort messages somehow (priority queue) and required for transport delay
-bool operator<(const playerState& lhs, const playerState& rhs){ 
+inline bool operator<(const playerState& lhs, const playerState& rhs){ 
     return true; 
 }
 
 //! It parses a JSON file and generates the corresponding playerState object
-void from_json(const nlohmann::json& j, playerState& s) {
+inline void from_json(const nlohmann::json& j, playerState& s) {
     j.at("has_player").get_to(s.has_player);
     j.at("has_ball").get_to(s.has_ball);
     j.at("has_obstacle").get_to(s.has_obstacle);
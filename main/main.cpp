@@ -1,24 +1,8 @@
-#include "nlohmann/json.hpp"
-#include <cadmium/modeling/celldevs/grid/coupled.hpp>
-#include <cadmium/simulation/logger/csv.hpp>
-#include <cadmium/simulation/root_coordinator.hpp>
-#include <chrono>
-#include <fstream>
+#include <iostream>
 #include <string>
-#include "include/playerCell.hpp"
-
-using namespace cadmium::celldevs;
-using namespace cadmium;
-
-std::shared_ptr<GridCell<playerState, double>> addGridCell(const coordinates & cellId, const std::shared_ptr<const GridCellConfig<playerState, double>>& cellConfig) {
-	auto cellModel = cellConfig->cellModel;
-
-	if (cellModel == "player") {
-		return std::make_shared<player>(cellId, cellConfig);
-	} else {
-		throw std::bad_typeid();
-	}
-}
+#include <vector>
+#include "include/api/simulation.hpp"
+#include "include/engine/gridLogger.hpp"
 
 int main(int argc, char ** argv) {
     if (argc < 2) {
@@ -29,13 +13,16 @@ int main(int argc, char ** argv) {
 	std::string configFilePath = argv[1];
 	double simTime = (argc > 2)? std::stod(argv[2]) : 500;
 
-    auto model = std::make_shared<GridCellDEVSCoupled<playerState, double>>("player", addGridCell, configFilePath);
-	model->buildModel();
+	Simulation simulation(configFilePath);
+
+	// same time window and log entries as the Cadmium coordinator (see cadmium_main.cpp)
+	GridLogger logger("grid_log.csv", ";");
+	logger.logGrid(0, simulation.getScenario(), simulation.grid());
 
-    auto rootCoordinator = RootCoordinator(model);
-	rootCoordinator.setLogger<CSVLogger>("grid_log.csv", ";");
-	
-	rootCoordinator.start();
-	rootCoordinator.simulate(simTime);
-	rootCoordinator.stop();
-}
\ No newline at end of file
+	std::vector<playerState> before;
+	while (simulation.time() <= simTime) {
+		before.assign(simulation.grid().begin(), simulation.grid().end());
+		simulation.step();
+		logger.logChanges(simulation.time() - 1, simulation.getScenario(), before, simulation.grid());
+	}
+}
@@ -0,0 +1,261 @@
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/fpi.h"
+#include "api/simulation.hpp"
+
+/***************************************************/
+/******************* C++ API ***********************/
+/***************************************************/
+
+namespace {
+    //! Throws std::invalid_argument if value is not one of the enumerators NONE (0) to last
+    template <typename Enumeration>
+    void checkEnumeration(const char* field, Enumeration value, Enumeration last) {
+        const int number = static_cast<int>(value);
+        if (number < 0 || number > static_cast<int>(last)) {
+            throw std::invalid_argument(std::string(field) + " " + std::to_string(number) + " is out of range [0, " + std::to_string(static_cast<int>(last)) + "]");
+        }
+    }
+}
+
+Simulation::Simulation(const std::string& configFilePath): Simulation(loadScenario(configFilePath)) {}
+
+Simulation::Simulation(Scenario scenario): engine(std::move(scenario)), threads(1) {
+    engine.enableObstacleField();
+    engine.enablePassivation();
+}
+
+void Simulation::step(int steps) {
+    for (int i = 0; i < steps; ++i) {
+        engine.step(threads);
+    }
+}
+
+long Simulation::time() const {
+    return engine.time();
+}
+
+int Simulation::rows() const {
+    return engine.getScenario().rows;
+}
+
+int Simulation::cols() const {
+    return engine.getScenario().cols;
+}
+
+std::span<const playerState> Simulation::grid() const {
+    return engine.states();
+}
+
+const playerState& Simulation::cell(int row, int col) const {
+    if (row < 0 || row >= rows() || col < 0 || col >= cols()) {
+        throw std::out_of_range("cell (" + std::to_string(row) + "," + std::to_string(col) + ") is outside the grid");
+    }
+    return engine.states()[engine.getScenario().index(row, col)];
+}
+
+void Simulation::setCell(int row, int col, const playerState& state) {
+    if (row < 0 || row >= rows() || col < 0 || col >= cols()) {
+        throw std::out_of_range("cell (" + std::to_string(row) + "," + std::to_string(col) + ") is outside the grid");
+    }
+    // an out-of-range role would only fail inside a later step (on a worker thread with several threads)
+    checkEnumeration("action", state.action, Action::HOLD);
+    checkEnumeration("direction", state.direction, Direction::WEST);
+    checkEnumeration("zone_type", state.zone_type, ZoneType::ATTACK);
+    checkEnumeration("player_role", state.player_role, PlayerRole::FALSE_NINE);
+    engine.setCell(row, col, state);
+}
+
+void Simulation::reset() {
+    engine.reset();
+}
+
+void Simulation::setSeed(std::uint64_t seed) {
+    engine.setSeed(seed);
+}
+
+void Simulation::clearSeed() {
+    engine.clearSeed();
+}
+
+void Simulation::setThreads(unsigned n) {
+    threads = n;
+}
+
+const Scenario& Simulation::getScenario() const {
+    return engine.getScenario();
+}
+
+/***************************************************/
+/********************* C API ***********************/
+/***************************************************/
+
+//! Simulation with a copy of its grid as fpi_cell_state values, refreshed by fpi_grid after the grid changed (C callers
+//! read real fpi_cell_state objects rather than the playerState array under another type)
+struct fpi_simulation {
+    Simulation simulation;
+    mutable std::vector<fpi_cell_state> grid;
+    mutable bool gridStale = true;
+};
+
+namespace {
+    thread_local std::string lastError;
+
+    //! Runs an API call, turning exceptions into the error message of the thread (returns false on error)
+    template <typename Function>
+    bool guarded(Function function) {
+        try {
+            function();
+            lastError.clear();
+            return true;
+        } catch (const std::exception& e) {
+            lastError = e.what();
+        } catch (...) {
+            lastError = "unknown error";
+        }
+        return false;
+    }
+
+    //! Simulation of a handle (throws std::invalid_argument if the handle is NULL)
+    template <typename Handle>
+    auto& checked(Handle* handle) {
+        if (handle == nullptr) {
+            throw std::invalid_argument("simulation is NULL");
+        }
+        return *handle;
+    }
+
+    fpi_cell_state toCellState(const playerState& s) {
+        fpi_cell_state state;
+        state.has_player = s.has_player;
+        state.has_ball = s.has_ball;
+        state.has_obstacle = s.has_obstacle;
+        state.near_obstacle = s.near_obstacle;
+        state.mental = s.mental;
+        state.fatigue = s.fatigue;
+        state.action = static_cast<int>(s.action);
+        state.direction = static_cast<int>(s.direction);
+        state.zone_type = static_cast<int>(s.zone_type);
+        state.player_role = static_cast<int>(s.player_role);
+        state.initial_row = s.initial_row;
+        state.inactive_time = s.inactive_time;
+        return state;
+    }
+
+    playerState toPlayerState(const fpi_cell_state& s) {
+        playerState state;
+        state.has_player = s.has_player;
+        state.has_ball = s.has_ball;
+        state.has_obstacle = s.has_obstacle;
+        state.near_obstacle = s.near_obstacle;
+        state.mental = s.mental;
+        state.fatigue = s.fatigue;
+        state.action = static_cast<Action>(s.action);
+        state.direction = static_cast<Direction>(s.direction);
+        state.zone_type = static_cast<ZoneType>(s.zone_type);
+        state.player_role = static_cast<PlayerRole>(s.player_role);
+        state.initial_row = s.initial_row;
+        state.inactive_time = s.inactive_time;
+        return state;
+    }
+}
+
+extern "C" {
+
+fpi_simulation* fpi_load(const char* config_path) {
+    std::unique_ptr<fpi_simulation> handle;
+    guarded([&]() {
+        if (config_path == nullptr) {
+            throw std::invalid_argument("config_path is NULL");
+        }
+        handle.reset(new fpi_simulation{Simulation(std::string(config_path))});
+    });
+    return handle.release();
+}
+
+void fpi_destroy(fpi_simulation* simulation) {
+    delete simulation;
+}
+
+const char* fpi_last_error(void) {
+    return lastError.c_str();
+}
+
+int fpi_rows(const fpi_simulation* simulation) {
+    int rows = -1;
+    guarded([&]() { rows = checked(simulation).simulation.rows(); });
+    return rows;
+}
+
+int fpi_cols(const fpi_simulation* simulation) {
+    int cols = -1;
+    guarded([&]() { cols = checked(simulation).simulation.cols(); });
+    return cols;
+}
+
+long fpi_time(const fpi_simulation* simulation) {
+    long time = -1;
+    guarded([&]() { time = checked(simulation).simulation.time(); });
+    return time;
+}
+
+int fpi_step(fpi_simulation* simulation, int steps) {
+    return guarded([&]() {
+        checked(simulation).gridStale = true;
+        simulation->simulation.step(steps);
+    }) ? 0 : -1;
+}
+
+const fpi_cell_state* fpi_grid(const fpi_simulation* simulation) {
+    const fpi_cell_state* grid = nullptr;
+    guarded([&]() {
+        const fpi_simulation& handle = checked(simulation);
+        if (handle.gridStale) {
+            const auto states = handle.simulation.grid();
+            handle.grid.resize(states.size());
+            for (std::size_t i = 0; i < states.size(); ++i) {
+                handle.grid[i] = toCellState(states[i]);
+            }
+            handle.gridStale = false;
+        }
+        grid = handle.grid.data();
+    });
+    return grid;
+}
+
+int fpi_set_cell(fpi_simulation* simulation, int row, int col, const fpi_cell_state* state) {
+    return guarded([&]() {
+        if (state == nullptr) {
+            throw std::invalid_argument("state is NULL");
+        }
+        checked(simulation).simulation.setCell(row, col, toPlayerState(*state));
+        simulation->gridStale = true;
+    }) ? 0 : -1;
+}
+
+int fpi_reset(fpi_simulation* simulation) {
+    return guarded([&]() {
+        checked(simulation).simulation.reset();
+        simulation->gridStale = true;
+    }) ? 0 : -1;
+}
+
+int fpi_set_seed(fpi_simulation* simulation, uint64_t seed) {
+    return guarded([&]() { checked(simulation).simulation.setSeed(seed); }) ? 0 : -1;
+}
+
+int fpi_clear_seed(fpi_simulation* simulation) {
+    return guarded([&]() { checked(simulation).simulation.clearSeed(); }) ? 0 : -1;
+}
+
+int fpi_set_threads(fpi_simulation* simulation, unsigned threads) {
+    return guarded([&]() { checked(simulation).simulation.setThreads(threads); }) ? 0 : -1;
+}
+
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/gridLogger.hpp"
+
+//! Cross-check of a Cadmium build of the model against the grid engine: every config/ scenario is run by the Cadmium
+//! program (football_player_cadmium, or the one of an older revision) and its grid_log.csv is compared, entry by entry,
+//! with the log of GridEngine over the same time window
+
+namespace fs = std::filesystem;
+
+extern char ** environ;
+
+//! Runs a simulator once in a directory and waits for it
+void runProcess(const std::string& program, const std::string& config, const std::string& simTime, const std::vector<std::string>& options,
+                const std::string& dir) {
+    std::vector<std::string> args = {program, config, simTime};
+    args.insert(args.end(), options.begin(), options.end());
+    std::vector<char*> argv;
+    for (auto& arg: args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addchdir_np(&actions, dir.c_str());
+    pid_t pid;
+    int status = 0;
+    bool spawned = posix_spawn(&pid, program.c_str(), &actions, nullptr, argv.data(), environ) == 0;
+    posix_spawn_file_actions_destroy(&actions);
+    if (!spawned || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("unable to run " + program);
+    }
+}
+
+//! Log entry: time, model id (row-major index + 1) and the rest of the line
+using LogEntry = std::tuple<long, long, std::string>;
+
+//! Entries of a grid_log.csv in (time, cell) order (the Cadmium logger writes the cells of an instant in any order)
+std::vector<LogEntry> readLog(const fs::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("missing log file " + path.string());
+    }
+    std::vector<LogEntry> entries;
+    std::string line;
+    std::getline(file, line);   // sep=;
+    std::getline(file, line);   // header
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string time;
+        std::string id;
+        std::getline(fields, time, ';');
+        std::getline(fields, id, ';');
+        entries.emplace_back(std::stol(time), std::stol(id), line);
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+//! Logs a grid engine run the way football_player_engine does (one step per time unit, changed cells only)
+void writeEngineLog(const Scenario& scenario, double simTime, const fs::path& path) {
+    GridEngine engine(scenario);
+    GridLogger logger(path.string(), ";");
+    logger.logGrid(0, scenario, engine.states());
+    std::vector<playerState> before;
+    while (engine.time() <= simTime) {
+        before.assign(engine.states().begin(), engine.states().end());
+        engine.step();
+        logger.logChanges(engine.time() - 1, scenario, before, engine.states());
+    }
+}
+
+//! First entry where two sorted logs differ (empty if they are the same)
+std::string firstDifference(const std::vector<LogEntry>& cadmium, const std::vector<LogEntry>& engine) {
+    const std::size_t common = std::min(cadmium.size(), engine.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        if (cadmium[i] != engine[i]) {
+            return "Cadmium \"" + std::get<2>(cadmium[i]) + "\", engine \"" + std::get<2>(engine[i]) + "\"";
+        }
+    }
+    if (cadmium.size() != engine.size()) {
+        const auto& extra = (cadmium.size() > engine.size()) ? cadmium[common] : engine[common];
+        return std::string(cadmium.size() > engine.size() ? "only Cadmium" : "only the engine") + " logs \"" + std::get<2>(extra) + "\"";
+    }
+    return "";
+}
+
+int main(int argc, char ** argv) {
+    std::string simTime = "500";
+    std::vector<std::string> paths;
+    std::vector<std::string> options;   // passed to the Cadmium program after the config and the time
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--") {
+            options.assign(argv + i + 1, argv + argc);
+            break;
+        } else if (arg == "--time" && i + 1 < argc) {
+            simTime = argv[++i];
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " CADMIUM_PROGRAM CONFIG_DIR [--time T (default: 500)] [-- PROGRAM_OPTIONS...]" << std::endl;
+        return -1;
+    }
+    const std::string program = fs::absolute(paths[0]).string();
+    const fs::path configDir = paths[1];
+
+    std::vector<fs::path> configs;
+    for (const auto& entry: fs::recursive_directory_iterator(configDir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            configs.push_back(fs::absolute(entry.path()));
+        }
+    }
+    std::sort(configs.begin(), configs.end());
+    if (configs.empty()) {
+        std::cout << "no scenario found in " << configDir << std::endl;
+        return 1;
+    }
+
+    const fs::path scratch = fs::temp_directory_path() / ("cadmium_cross_check_" + std::to_string(::getpid()));
+    fs::create_directories(scratch);
+    int failures = 0;
+    for (const auto& config: configs) {
+        const std::string name = fs::relative(config, fs::absolute(configDir)).generic_string();
+        try {
+            runProcess(program, config.string(), simTime, options, scratch.string());
+            writeEngineLog(loadScenario(config.string()), std::stod(simTime), scratch / "engine_log.csv");
+            const std::string difference = firstDifference(readLog(scratch / "grid_log.csv"), readLog(scratch / "engine_log.csv"));
+            std::cout << (difference.empty() ? "PASS " : "FAIL ") << name << (difference.empty() ? "" : ": " + difference) << std::endl;
+            failures += difference.empty() ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cout << "FAIL " << name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+        fs::remove(scratch / "grid_log.csv");
+    }
+    fs::remove_all(scratch);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include "include/daemon/simulationDaemon.hpp"
+
+//! Simulation daemon run in-process: warm repeated jobs, rejected jobs and log paths, and shutdown
+
+namespace fs = std::filesystem;
+
+int failures = 0;
+
+void check(bool ok, const std::string& name) {
+    std::cout << (ok ? "PASS " : "FAIL ") << name << std::endl;
+    failures += ok ? 0 : 1;
+}
+
+//! Sends one raw line on a new connection and returns the reply line (empty if the daemon closed the connection)
+std::string rawRequest(const std::string& socketPath, const std::string& line) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    const sockaddr_un address = socketAddress(socketPath);
+    std::string reply;
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 && sendAll(fd, line + "\n")) {
+        LineReader reader(fd);
+        reply = reader.next().value_or("");
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return reply;
+}
+
+//! grid_hash of a job run by Simulation directly (same time window as runJob)
+std::string expectedHash(const std::string& config, double simTime) {
+    Simulation simulation(config);
+    while (simulation.time() <= simTime) {
+        simulation.step();
+    }
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(hashGrid(simulation.grid())));
+    return hash;
+}
+
+int main(int argc, char ** argv) {
+    if (argc != 2) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " CONFIG_DIR" << std::endl;
+        return -1;
+    }
+    const std::string config = (fs::path(argv[1]) / "without_obstacles" / "10x10_player_config.json").string();
+    const fs::path scratch = fs::temp_directory_path() / ("daemon_test_" + std::to_string(::getpid()));
+    fs::create_directories(scratch / "logs");
+    const std::string socketPath = (scratch / "daemon.sock").string();
+
+    SimulationDaemon daemon(socketPath, 2, 8, 1000, (scratch / "logs").string());
+    auto served = std::async(std::launch::async, [&daemon]() { daemon.serve(); });
+    {
+        DaemonClient client(socketPath);
+
+        // a repeated job reuses the parsed scenario and the grid of the worker, and ends in the grid of a direct run
+        const std::string hash = expectedHash(config, 50);
+        nlohmann::json first = client.request({{"config", config}, {"time", 50}, {"id", 1}});
+        check(first.value("ok", false) && first.value("grid_hash", "") == hash && first.value("steps", 0) == 51, "first job: grid of a Simulation run");
+        bool warm = false;
+        // with two workers the second job may reach the other one, which has not allocated the grid yet
+        for (int i = 0; i < 4 && !warm; ++i) {
+            nlohmann::json repeated = client.request({{"config", config}, {"time", 50}, {"id", 2}});
+            warm = repeated.value("ok", false) && repeated.value("warm_scenario", false) && repeated.value("warm_grid", false) &&
+                   repeated.value("grid_hash", "") == hash && repeated.at("id") == 2;
+        }
+        check(warm, "repeated job: warm scenario and grid, same grid_hash");
+
+        // rejected jobs get an error reply with their id, and the connection stays usable
+        nlohmann::json late = client.request({{"config", config}, {"time", 1001}, {"id", 3}});
+        check(!late.value("ok", true) && late.at("id") == 3, "time above the limit is rejected");
+        nlohmann::json negative = client.request({{"config", config}, {"time", -1}, {"id", 4}});
+        check(!negative.value("ok", true) && negative.at("id") == 4, "negative time is rejected");
+        nlohmann::json missing = client.request({{"config", (scratch / "missing.json").string()}, {"time", 10}});
+        check(!missing.value("ok", true), "missing scenario file is reported");
+
+        // logs are only written under the log directory
+        nlohmann::json absolute = client.request({{"config", config}, {"time", 10}, {"log", (scratch / "log.csv").string()}});
+        check(!absolute.value("ok", true) && !fs::exists(scratch / "log.csv"), "absolute log path is rejected");
+        nlohmann::json parent = client.request({{"config", config}, {"time", 10}, {"log", "../log.csv"}});
+        check(!parent.value("ok", true) && !fs::exists(scratch / "log.csv"), "log path with .. is rejected");
+        nlohmann::json logged = client.request({{"config", config}, {"time", 10}, {"log", "log.csv"}});
+        check(logged.value("ok", false) && logged.value("changes", 0L) > 0 && fs::exists(scratch / "logs" / "log.csv"), "relative log path is written in the log directory");
+    }
+
+    nlohmann::json malformed = nlohmann::json::parse(rawRequest(socketPath, "{\"config\": "), nullptr, false);
+    check(malformed.is_object() && !malformed.value("ok", true), "malformed line gets an error reply");
+    nlohmann::json noConfig = nlohmann::json::parse(rawRequest(socketPath, "[1, 2]"), nullptr, false);
+    check(noConfig.is_object() && !noConfig.value("ok", true), "request that is not a job gets an error reply");
+
+    nlohmann::json stopped = nlohmann::json::parse(rawRequest(socketPath, "{\"command\": \"shutdown\"}"), nullptr, false);
+    check(stopped.is_object() && stopped.value("ok", false), "shutdown is acknowledged");
+    check(served.wait_for(std::chrono::seconds(10)) == std::future_status::ready, "serve returns after shutdown");
+
+    served.wait();
+    fs::remove_all(scratch);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "include/engine/cellCoordinator.hpp"
+#include "include/engine/entityEngine.hpp"
+#include "include/engine/fixedGridEngine.hpp"
+#include "include/engine/gridEngine.hpp"
+#include "include/engine/multiResolutionEngine.hpp"
+#include "include/engine/stateHash.hpp"
+
+namespace fs = std::filesystem;
+
+//! Frames of a run: frame 0 is the initial grid and frame k the grid computed at time k-1
+//! (time 0 to 500, the default MAX_SIMULATION_TIME of football_player_interaction)
+constexpr long FRAMES = 502;
+
+//! Called with every frame of a run (returns false to stop the run)
+using FrameCallback = std::function<bool(long frame, std::span<const playerState> grid)>;
+
+//! Stochastic mode seed of a run (std::nullopt: deterministic rules)
+using Seed = std::optional<std::uint64_t>;
+
+//! Engine validated against the golden hashes (run returns false if it does not support the scenario or the seed)
+struct EngineUnderTest {
+    std::string name;
+    std::function<bool(const Scenario&, Seed, const FrameCallback&)> run;
+};
+
+template <typename Engine, typename Step>
+void runFrames(Engine& engine, Seed seed, const FrameCallback& onFrame, Step step) {
+    if (seed) {
+        engine.setSeed(*seed);
+    }
+    if (!onFrame(0, engine.states())) {
+        return;
+    }
+    for (long frame = 1; frame < FRAMES; ++frame) {
+        step(engine);
+        if (!onFrame(frame, engine.states())) {
+            return;
+        }
+    }
+}
+
+//! Event-driven coordinator: frame k holds every event up to time k-1 (no stochastic mode, like the Cadmium cell)
+template <typename Store, unsigned Threads = 1, typename Model = PlayerCellModel>
+bool runCoordinator(const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+    if (seed) {
+        return false;
+    }
+    auto model = std::make_shared<const Model>();
+    CellCoordinator<Store> coordinator(scenario, [&model](int, int) { return model; });
+    coordinator.setThreads(Threads, 1);     // split every instant, however small
+    coordinator.start();
+    if (!onFrame(0, coordinator.states())) {
+        return true;
+    }
+    for (long frame = 1; frame < FRAMES; ++frame) {
+        coordinator.simulateUntil(static_cast<double>(frame - 1));
+        if (!onFrame(frame, coordinator.states())) {
+            break;
+        }
+    }
+    return true;
+}
+
+const std::vector<EngineUnderTest> engines = {
+    {"grid", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        return true;
+    }},
+    {"grid (4 threads)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(4); });
+        return true;
+    }},
+    {"grid (bitboards, 2 threads)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        engine.enableBitboards();
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(2); });
+        return true;
+    }},
+    {"grid (obstacle field)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        engine.enableObstacleField();
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        return true;
+    }},
+    {"grid (obstacle field, bitboards, 3 threads)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        engine.enableObstacleField();
+        engine.enableBitboards();
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(3); });
+        return true;
+    }},
+    {"grid (passivation)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        engine.enablePassivation();
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        return true;
+    }},
+    {"grid (passivation, obstacle field, 3 threads)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        GridEngine engine(scenario);
+        engine.enablePassivation();
+        engine.enableObstacleField();
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(3); });
+        return true;
+    }},
+    {"fixed", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        return visitFixedGridEngine(scenario, [&seed, &onFrame](auto& engine) {
+            runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        });
+    }},
+    {"multi-resolution (2x2 tiles)", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        MultiResolutionEngine engine(scenario, 2);
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        return true;
+    }},
+    {"entities", [](const Scenario& scenario, Seed seed, const FrameCallback& onFrame) {
+        EntityEngine engine(scenario);
+        runFrames(engine, seed, onFrame, [](auto& e) { e.step(); });
+        return true;
+    }},
+    {"coordinator (shared snapshots)", runCoordinator<SharedMessageStore>},
+    {"coordinator (pooled)", runCoordinator<PooledMessageStore>},
+    {"coordinator (pooled, 4 threads)", runCoordinator<PooledMessageStore, 4>},
+    {"coordinator (passive cells, 4 threads)", runCoordinator<PooledMessageStore, 4, PassivePlayerCellModel>},
+};
+
+//! Stochastic runs checked in addition to the deterministic run of every scenario (config path relative to the
+//! config directory); the coordinator has no stochastic mode and skips them
+const std::vector<std::pair<std::string, std::uint64_t>> seededRuns = {
+    {"with_obstacles/with_zones/with_roles/10x10_player_config.json", 42},
+    {"without_obstacles/3x3_player_dribble_config.json", 7},
+};
+
+//! Golden file contents: the hash of every frame and the hash of the cells that changed in it
+struct GoldenCell {
+    int index;
+    std::uint64_t hash;
+};
+
+struct GoldenFrame {
+    std::uint64_t hash;
+    std::vector<GoldenCell> cells;
+};
+
+struct Golden {
+    int rows = 0;
+    int cols = 0;
+    std::vector<GoldenFrame> frames;
+};
+
+std::string toHex(std::uint64_t value) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << value;
+    return out.str();
+}
+
+std::string frameLabel(long frame) {
+    return (frame == 0) ? "init" : std::to_string(frame - 1);
+}
+
+std::vector<std::uint64_t> hashEachCell(std::span<const playerState> grid) {
+    std::vector<std::uint64_t> hashes(grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        hashes[i] = hashState(grid[i]);
+    }
+    return hashes;
+}
+
+//! Records the reference run of a scenario
+//! The reference is the synchronous grid engine running playerRules.hpp, not a Cadmium run of the original cell: the
+//! golden files lock in the current rules (and catch any engine drifting from them), not the pre-refactor model.
+//! cadmium_cross_check compares a Cadmium build of the model with the grid engine.
+void writeGolden(const Scenario& scenario, Seed seed, const fs::path& configPath, const fs::path& goldenPath) {
+    fs::create_directories(goldenPath.parent_path());
+    std::ofstream out(goldenPath);
+    out << "# per-frame grid hashes of " << configPath.generic_string();
+    out << (seed ? " with seed " + std::to_string(*seed) : std::string()) << " (frame init, then time 0 to " << FRAMES - 2 << ")\n";
+    out << "# recorded with the synchronous grid engine (" << engines.front().name << ") and the rules of playerRules.hpp\n";
+    out << "shape " << scenario.rows << " " << scenario.cols << "\n";
+
+    std::vector<std::uint64_t> previous;
+    engines.front().run(scenario, seed, [&](long frame, std::span<const playerState> grid) {
+        auto cells = hashEachCell(grid);
+        out << "frame " << frameLabel(frame) << " " << toHex(hashCells(cells)) << "\n";
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (previous.empty() || previous[i] != cells[i]) {
+                out << "cell " << i / scenario.cols << " " << i % scenario.cols << " " << toHex(cells[i]) << "\n";
+            }
+        }
+        previous = std::move(cells);
+        return true;
+    });
+}
+
+Golden readGolden(const fs::path& goldenPath) {
+    std::ifstream in(goldenPath);
+    if (!in) {
+        throw std::runtime_error("missing golden file " + goldenPath.string() + " (run with --update to record it)");
+    }
+
+    Golden golden;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "shape") {
+            fields >> golden.rows >> golden.cols;
+        } else if (kind == "frame") {
+            std::string label;
+            std::uint64_t hash;
+            fields >> label >> std::hex >> hash;
+            golden.frames.push_back({hash, {}});
+        } else if (kind == "cell") {
+            int row, col;
+            std::uint64_t hash;
+            fields >> row >> col >> std::hex >> hash;
+            golden.frames.back().cells.push_back({row * golden.cols + col, hash});
+        }
+    }
+    return golden;
+}
+
+//! Runs an engine and compares every frame hash; on a mismatch it reports the first differing time step and cell
+bool checkEngine(const EngineUnderTest& engine, const Scenario& scenario, Seed seed, const Golden& golden, const std::string& name) {
+    std::vector<std::uint64_t> expected(scenario.size(), 0);
+    std::string failure;
+    long checked = 0;
+
+    bool supported = engine.run(scenario, seed, [&](long frame, std::span<const playerState> grid) {
+        if (frame >= static_cast<long>(golden.frames.size())) {
+            failure = "golden file has fewer frames than the run";
+            return false;
+        }
+        for (const auto& cell: golden.frames[frame].cells) {
+            expected[cell.index] = cell.hash;
+        }
+        ++checked;
+
+        auto cells = hashEachCell(grid);
+        if (hashCells(cells) == golden.frames[frame].hash) {
+            return true;
+        }
+
+        std::ostringstream report;
+        report << "first difference at time " << frameLabel(frame);
+        for (int i = 0; i < scenario.size(); ++i) {
+            if (cells[i] != expected[i]) {
+                report << ", cell (" << scenario.originRow + i / scenario.cols << "," << scenario.originCol + i % scenario.cols << ")"
+                       << " is " << grid[i] << " (hash " << toHex(cells[i]) << ", expected " << toHex(expected[i]) << ")";
+                break;
+            }
+        }
+        failure = report.str();
+        return false;
+    });
+
+    if (!supported) {
+        return true;
+    }
+    if (failure.empty() && checked != static_cast<long>(golden.frames.size())) {
+        failure = "run stopped after " + std::to_string(checked) + " of " + std::to_string(golden.frames.size()) + " frames";
+    }
+    std::cout << (failure.empty() ? "PASS " : "FAIL ") << name << " [" << engine.name << "]";
+    std::cout << (failure.empty() ? "" : ": " + failure) << std::endl;
+    return failure.empty();
+}
+
+int main(int argc, char ** argv) {
+    bool update = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--update") {
+            update = true;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cout << "Program used with wrong parameters. The program must be invoked as follows:";
+        std::cout << argv[0] << " [--update] CONFIG_DIR GOLDEN_DIR" << std::endl;
+        return -1;
+    }
+    const fs::path configDir = paths[0];
+    const fs::path goldenDir = paths[1];
+
+    std::vector<fs::path> configs;
+    for (const auto& entry: fs::recursive_directory_iterator(configDir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            configs.push_back(entry.path());
+        }
+    }
+    std::sort(configs.begin(), configs.end());
+
+    // every scenario with the deterministic rules, and the seeded runs that exist in configDir
+    std::vector<std::pair<fs::path, Seed>> runs;
+    for (const auto& config: configs) {
+        runs.emplace_back(config, std::nullopt);
+    }
+    for (const auto& [relative, seed]: seededRuns) {
+        if (fs::exists(configDir / relative)) {
+            runs.emplace_back(configDir / relative, seed);
+        }
+    }
+
+    int failures = 0;
+    for (const auto& [config, seed]: runs) {
+        const fs::path relative = fs::relative(config, configDir);
+        const std::string seedSuffix = seed ? ".seed" + std::to_string(*seed) : "";
+        const fs::path goldenPath = (goldenDir / relative).replace_extension(seedSuffix + ".hash");
+        const std::string name = relative.generic_string() + (seed ? " (seed " + std::to_string(*seed) + ")" : "");
+
+        // a scenario that cannot be loaded fails on its own, the other runs go on
+        try {
+            const Scenario scenario = loadScenario(config.string());
+            if (update) {
+                writeGolden(scenario, seed, relative, goldenPath);
+                std::cout << "UPDATED " << goldenPath.generic_string() << std::endl;
+                continue;
+            }
+
+            const Golden golden = readGolden(goldenPath);
+            if (golden.rows != scenario.rows || golden.cols != scenario.cols) {
+                throw std::runtime_error("golden file shape does not match the scenario (run with --update to record it)");
+            }
+            for (const auto& engine: engines) {
+                failures += checkEngine(engine, scenario, seed, golden, name) ? 0 : 1;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "FAIL " << name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+
+    if (configs.empty()) {
+        std::cout << "no scenario found in " << configDir << std::endl;
+        return 1;
+    }
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "include/playerRules.hpp"
+
+//! Neighbor rules whose outcome depends on several neighbors at once, and the neighbor lookup on wrapped grids
+
+int failures = 0;
+
+void check(bool ok, const std::string& name) {
+    std::cout << (ok ? "PASS " : "FAIL ") << name << std::endl;
+    failures += ok ? 0 : 1;
+}
+
+playerState dribbling(Direction direction) {
+    playerState s;
+    s.action = Action::DRIBBLE;
+    s.direction = direction;
+    return s;
+}
+
+NeighborFlags flagsOf(const NeighborStates& neighbors) {
+    playerState state;
+    SourcePlayer source;
+    return collectNeighborFlags(state, neighbors, source);
+}
+
+int main() {
+    const playerState empty;
+    const playerState north = dribbling(Direction::NORTH);
+    const playerState south = dribbling(Direction::SOUTH);
+
+    // north_dribble/south_dribble are overwritten by each side neighbor, visited west then east, so an east neighbor
+    // that does not dribble hides the dribble of the west one; OR-ing the flags would raise them
+    NeighborStates neighbors{};
+    neighbors[WEST_SLOT] = &north;
+    check(flagsOf(neighbors).north_dribble, "west dribble north, no east neighbor: north_dribble");
+    neighbors[EAST_SLOT] = &empty;
+    check(!flagsOf(neighbors).north_dribble, "west dribble north, idle east neighbor: no north_dribble");
+    neighbors[WEST_SLOT] = &empty;
+    neighbors[EAST_SLOT] = &south;
+    check(flagsOf(neighbors).south_dribble, "idle west neighbor, east dribble south: south_dribble");
+    neighbors[WEST_SLOT] = &north;
+    NeighborFlags flags = flagsOf(neighbors);
+    check(!flags.north_dribble && flags.south_dribble, "west dribble north, east dribble south: only south_dribble");
+
+    // a rested off-ball player next to the west dribble only follows it when the east side is outside the grid
+    playerState player;
+    player.has_player = true;
+    player.mental = 60.0;
+    player.fatigue = 10.0;
+    player.initial_row = 5;
+    NeighborStates around{};
+    around[NORTH_SLOT] = &empty;
+    around[WEST_SLOT] = &north;
+    playerState next = playerTransition(player, around, 5);
+    check(isActionFromDirection(next, Action::MOVE, Direction::NORTH), "off-ball player follows a west dribble at the east edge");
+    around[EAST_SLOT] = &empty;
+    next = playerTransition(player, around, 5);
+    check(!isActionFromDirection(next, Action::MOVE, Direction::NORTH), "off-ball player ignores a west dribble next to an idle east cell");
+
+    // the neighbors across the edges of a wrapped grid (the engines and the Cadmium cell share neighborCoordinates)
+    using Cell = std::optional<std::array<int, 2>>;
+    check(neighborCoordinates(0, 4, NORTH_SLOT, 10, 10, true, 2) == Cell({9, 4}), "wrapped north neighbor of row 0 is the last row");
+    check(neighborCoordinates(1, 4, NORTH_EXTENDED_SLOT, 10, 10, true, 2) == Cell({9, 4}), "wrapped extended north neighbor of row 1 is the last row");
+    check(neighborCoordinates(3, 9, EAST_SLOT, 10, 10, true, 2) == Cell({3, 0}), "wrapped east neighbor of the last column is column 0");
+    check(!neighborCoordinates(0, 4, NORTH_SLOT, 10, 10, false, 2), "no north neighbor of row 0 without wrapping");
+    check(!neighborCoordinates(5, 4, SOUTH_EXTENDED_SLOT, 10, 10, true, 1), "no extended neighbor with range 1");
+
+    // a Cadmium neighborhood map on a wrapped 3x3 grid: the south neighbor of row 0 is also its extended north one
+    const NeighborSlotIds ids(0, 1, 0, 0, 3, 3, true, 2);
+    const playerState below = dribbling(Direction::NORTH);
+    std::map<std::vector<int>, const playerState*> neighborhood = {{{1, 1}, &below}, {{2, 1}, &empty}, {{0, 0}, &empty}, {{0, 2}, &empty}};
+    const NeighborStates gathered = ids.gather(neighborhood, [](const playerState* s) { return s; });
+    check(gathered[SOUTH_SLOT] == &below && gathered[NORTH_EXTENDED_SLOT] == &below && gathered[NORTH_SLOT] == &empty &&
+          gathered[SOUTH_EXTENDED_SLOT] == &empty, "wrapped 3x3 neighborhood map fills every slot of a neighbor");
+
+    return (failures == 0) ? 0 : 1;
+}